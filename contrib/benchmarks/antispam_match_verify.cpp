@@ -0,0 +1,181 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks the antispam matching kernels against their reference versions on random inputs:
+// nam::damerau_levenshtein_matcher against the scalar nam::damerau_levenshtein_distance and
+// nam::aho_corasick against one std::string::find per pattern. Small alphabets make matches,
+// repeats and transpositions frequent, long strings cross the 64 bit word boundaries.
+
+#include "Platform/Define.h"
+#include "ahocorasick.hpp"
+#include "dldist.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static std::string RandomString(std::mt19937& rng, size_t length, char alphabet)
+{
+    std::uniform_int_distribution<int> letter(0, alphabet - 1);
+
+    std::string result(length, 'a');
+    for (auto& c : result)
+        c = char('a' + letter(rng));
+    return result;
+}
+
+// the second string is mostly an edited copy of the first one, so that distances are small
+static std::string Mutate(std::mt19937& rng, std::string text, char alphabet)
+{
+    std::uniform_int_distribution<int> letter(0, alphabet - 1);
+    std::uniform_int_distribution<int> edits(0, 6);
+
+    for (int i = edits(rng); i > 0 && !text.empty(); --i)
+    {
+        size_t pos = std::uniform_int_distribution<size_t>(0, text.length() - 1)(rng);
+        switch (rng() % 4)
+        {
+            case 0: text.erase(pos, 1); break;
+            case 1: text.insert(pos, 1, char('a' + letter(rng))); break;
+            case 2: text[pos] = char('a' + letter(rng)); break;
+            case 3:
+                if (pos + 1 < text.length())
+                    std::swap(text[pos], text[pos + 1]);
+                break;
+        }
+    }
+    return text;
+}
+
+static uint32 VerifyDistance(std::mt19937& rng, uint32 rounds, double& scalarTime, double& matcherTime)
+{
+    std::uniform_int_distribution<size_t> length(0, 200);
+    std::uniform_int_distribution<int> alphabet(2, 26);
+    std::uniform_int_distribution<uint32_t> bound(1, 40);
+
+    uint32 mismatches = 0;
+    for (uint32 i = 0; i < rounds; ++i)
+    {
+        char letters = char(alphabet(rng));
+        std::string pattern = RandomString(rng, length(rng), letters);
+        std::string text = rng() % 4 ? Mutate(rng, pattern, letters) : RandomString(rng, length(rng), letters);
+
+        auto start = std::chrono::steady_clock::now();
+        uint32_t expected = uint32_t(nam::damerau_levenshtein_distance(pattern, text));
+        auto middle = std::chrono::steady_clock::now();
+        nam::damerau_levenshtein_matcher const matcher(pattern);
+        uint32_t exact = matcher.distance(text);
+        auto end = std::chrono::steady_clock::now();
+
+        scalarTime += std::chrono::duration<double, std::milli>(middle - start).count();
+        matcherTime += std::chrono::duration<double, std::milli>(end - middle).count();
+
+        // below the bound the distance is exact, at or above it only has to stay at or above it
+        uint32_t limit = bound(rng);
+        uint32_t bounded = matcher.distance(text, limit);
+        bool boundedOk = expected < limit ? bounded == expected : bounded >= limit;
+
+        if (exact != expected || !boundedOk)
+        {
+            if (++mismatches <= 10)
+                printf("distance mismatch: \"%s\" \"%s\" expected %u got %u, bound %u got %u\n",
+                       pattern.c_str(), text.c_str(), expected, exact, limit, bounded);
+        }
+    }
+    return mismatches;
+}
+
+static uint32 VerifySearch(std::mt19937& rng, uint32 rounds, double& scalarTime, double& automatonTime)
+{
+    std::uniform_int_distribution<size_t> patternCount(1, 40);
+    std::uniform_int_distribution<size_t> patternLength(0, 6);
+    std::uniform_int_distribution<size_t> textLength(0, 300);
+    std::uniform_int_distribution<int> alphabet(2, 8);
+
+    uint32 mismatches = 0;
+    for (uint32 i = 0; i < rounds; ++i)
+    {
+        char letters = char(alphabet(rng));
+
+        // duplicate and empty patterns are allowed, like in the blacklist table
+        std::vector<std::string> patterns(patternCount(rng));
+        for (auto& pattern : patterns)
+            pattern = RandomString(rng, patternLength(rng), letters);
+        std::string text = RandomString(rng, textLength(rng), letters);
+
+        // (id, position) of every occurrence, overlapping ones included
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::pair<uint32, size_t>> expected;
+        for (uint32 id = 0; id < patterns.size(); ++id)
+        {
+            if (patterns[id].empty())
+                continue;
+            for (size_t pos = text.find(patterns[id]); pos != std::string::npos; pos = text.find(patterns[id], pos + 1))
+                expected.emplace_back(id, pos);
+        }
+        auto middle = std::chrono::steady_clock::now();
+
+        nam::aho_corasick automaton;
+        for (auto const& pattern : patterns)
+            automaton.add(pattern);
+        automaton.build();
+
+        std::vector<std::pair<uint32, size_t>> found;
+        automaton.find_all(text, [&found](uint32_t id, size_t pos) { found.emplace_back(id, pos); });
+        auto end = std::chrono::steady_clock::now();
+
+        scalarTime += std::chrono::duration<double, std::milli>(middle - start).count();
+        automatonTime += std::chrono::duration<double, std::milli>(end - middle).count();
+
+        // the automaton reports by end position, compare both in the order of the reference
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        if (found != expected)
+        {
+            if (++mismatches <= 10)
+                printf("search mismatch: text \"%s\", %u patterns, expected %u occurrences got %u\n",
+                       text.c_str(), uint32(patterns.size()), uint32(expected.size()), uint32(found.size()));
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    uint32 rounds = argc > 1 ? atoi(argv[1]) : 100000;
+    uint32 seed = argc > 2 ? atoi(argv[2]) : 12345;
+
+    std::mt19937 rng(seed);
+
+    double scalarDistanceTime = 0.0, matcherTime = 0.0;
+    uint32 distanceMismatches = VerifyDistance(rng, rounds, scalarDistanceTime, matcherTime);
+
+    double scalarSearchTime = 0.0, automatonTime = 0.0;
+    uint32 searchMismatches = VerifySearch(rng, rounds, scalarSearchTime, automatonTime);
+
+    printf("%u rounds, seed %u\n", rounds, seed);
+    printf("distance: scalar %.2f ms, bit-parallel %.2f ms, %u mismatches\n", scalarDistanceTime, matcherTime, distanceMismatches);
+    printf("search:   find %.2f ms, aho-corasick %.2f ms (build included), %u mismatches\n", scalarSearchTime, automatonTime, searchMismatches);
+
+    return distanceMismatches || searchMismatches ? 2 : 0;
+}
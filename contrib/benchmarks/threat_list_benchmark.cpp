@@ -0,0 +1,185 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Times the ordering of a threat list the way ThreatContainer did it before and does it now, for 5, 25 and
+// 100 attackers. HostileReference needs a live map, so a plain reference holding the sort criteria stands in:
+//   list:  the former std::list of references, any threat change which may reorder marks it dirty and the
+//          next update sorts the whole list
+//   flat:  ThreatOrder, the flat arrays ThreatContainer keeps its references in, used as is
+// Every tick some attackers gain threat, the most hated is read, and now and then an attacker leaves and
+// another one joins. Both orders are compared after every update.
+
+#include "Combat/ThreatOrder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+class Reference
+{
+    public:
+        explicit Reference(float threat) : m_threat(threat), m_listIndex(0), m_pendingIndex(ThreatOrder<Reference>::NOT_PENDING) {}
+
+        float getThreat() const { return m_threat; }
+        TauntState GetTauntState() const { return STATE_NONE; }
+        HostileState GetHostileState() const { return STATE_NORMAL; }
+
+        void addThreat(float mod) { m_threat += mod; }
+
+    private:
+        friend class ThreatOrder<Reference>;
+
+        float m_threat;
+        uint32 m_listIndex;
+        uint32 m_pendingIndex;
+        char m_unitData[96];                                // the rest of a HostileReference, spreads them in memory
+};
+
+class ListContainer
+{
+    public:
+        ListContainer() : m_victim(nullptr), m_dirty(false) {}
+
+        void add(Reference* ref) { m_list.push_back(ref); m_dirty = true; }
+        void remove(Reference* ref)
+        {
+            m_list.remove(ref);
+            if (ref == m_victim)
+                m_victim = nullptr;
+            m_dirty = true;
+        }
+
+        void addThreat(Reference* ref, float mod)
+        {
+            ref->addThreat(mod);
+            if ((ref == m_victim && mod < 0.f) || (ref != m_victim && mod > 0.f))
+                m_dirty = true;
+        }
+
+        Reference* update()
+        {
+            if (m_dirty && m_list.size() > 1)
+                m_list.sort([](Reference const* lhs, Reference const* rhs) { return ThreatSortKey(lhs) < ThreatSortKey(rhs); });
+            m_dirty = false;
+            m_victim = m_list.empty() ? nullptr : m_list.front();
+            return m_victim;
+        }
+
+        template<class F> void forEach(F&& f) const { for (Reference const* ref : m_list) f(ref); }
+
+    private:
+        std::list<Reference*> m_list;
+        Reference* m_victim;
+        bool m_dirty;
+};
+
+// the calls ThreatContainer and ThreatManager make on their ThreatOrder
+class FlatContainer
+{
+    public:
+        void add(Reference* ref) { m_order.add(ref); }
+        void remove(Reference* ref) { m_order.remove(ref); }
+
+        void addThreat(Reference* ref, float mod)
+        {
+            ref->addThreat(mod);
+            m_order.changed(ref);
+        }
+
+        Reference* update()
+        {
+            m_order.update();
+            return m_order.refs().empty() ? nullptr : m_order.refs().front();
+        }
+
+        template<class F> void forEach(F&& f) const { for (Reference const* ref : m_order.refs()) f(ref); }
+
+    private:
+        ThreatOrder<Reference> m_order;
+};
+
+// one fight: the same random events for both containers, each on its own copy of the references
+template<class Container>
+static double RunFight(uint32 attackers, uint32 ticks, uint32 changesPerTick, uint32 seed, std::vector<float>& order, std::vector<float>& checksums)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> threat(1.f, 1000.f);
+
+    std::vector<std::unique_ptr<Reference>> refs;
+    Container container;
+    for (uint32 i = 0; i < attackers; ++i)
+    {
+        refs.push_back(std::make_unique<Reference>(threat(rng)));
+        container.add(refs.back().get());
+    }
+
+    float checksum = 0.f;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        for (uint32 i = 0; i < changesPerTick; ++i)
+            container.addThreat(refs[rng() % refs.size()].get(), threat(rng));
+
+        // an attacker dies and another one joins
+        if (tick % 50 == 49)
+        {
+            size_t leaving = rng() % refs.size();
+            container.remove(refs[leaving].get());
+            refs[leaving] = std::make_unique<Reference>(threat(rng));
+            container.add(refs[leaving].get());
+        }
+
+        if (Reference* victim = container.update())
+            checksum += victim->getThreat();
+
+        if (tick % 1000 == 999)
+            checksums.push_back(checksum);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    container.forEach([&order](Reference const* ref) { order.push_back(ref->getThreat()); });
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    uint32 ticks = argc > 1 ? atoi(argv[1]) : 200000;
+    uint32 changesPerTick = argc > 2 ? atoi(argv[2]) : 3;
+
+    printf("%u updates, %u threat changes per update\n", ticks, changesPerTick);
+    printf("attackers       list      flat\n");
+
+    bool mismatch = false;
+    for (uint32 attackers : { 5u, 25u, 100u })
+    {
+        std::vector<float> listOrder, flatOrder, listChecksums, flatChecksums;
+        double listTime = RunFight<ListContainer>(attackers, ticks, changesPerTick, 12345 + attackers, listOrder, listChecksums);
+        double flatTime = RunFight<FlatContainer>(attackers, ticks, changesPerTick, 12345 + attackers, flatOrder, flatChecksums);
+
+        bool same = listOrder == flatOrder && listChecksums == flatChecksums;
+        mismatch |= !same;
+
+        printf("%9u %6.1f ms %6.1f ms%s\n", attackers, listTime, flatTime, same ? "" : "  order differs");
+    }
+
+    return mismatch ? 2 : 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Compares the scalar and the batched line of sight queries of VMapManager2 on one tile of extracted vmaps.
+// Rays are grouped like AoE target selection: one center and a number of targets around it.
+
+#include "VMapManager2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+static const float GRID_SIZE = 533.33333f;
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("usage: %s <vmaps dir> <map id> <tile x> <tile y> [centers = 2000] [targets per center = 25]\n", argv[0]);
+        return 1;
+    }
+
+    std::string basePath = argv[1];
+    uint32 mapId = atoi(argv[2]);
+    int tileX = atoi(argv[3]);
+    int tileY = atoi(argv[4]);
+    uint32 centers = argc > 5 ? atoi(argv[5]) : 2000;
+    uint32 targetsPerCenter = argc > 6 ? atoi(argv[6]) : 25;
+
+    auto vmgr = std::make_unique<VMAP::VMapManager2>();
+    vmgr->setEnableLineOfSightCalc(true);
+    vmgr->setEnableHeightCalc(true);
+    if (vmgr->loadMap(basePath.c_str(), mapId, tileX, tileY) != VMAP::VMAP_LOAD_RESULT_OK)
+    {
+        printf("could not load vmap tile %03u %02i,%02i from %s\n", mapId, tileX, tileY, basePath.c_str());
+        return 1;
+    }
+
+    // same tile to world mapping as TerrainInfo::LoadMapAndVMap
+    float maxX = (32 - tileX) * GRID_SIZE;
+    float maxY = (32 - tileY) * GRID_SIZE;
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> inTileX(maxX - GRID_SIZE, maxX);
+    std::uniform_real_distribution<float> inTileY(maxY - GRID_SIZE, maxY);
+    std::uniform_real_distribution<float> around(-30.f, 30.f);
+
+    // place points on the vmap ground where there is one, so rays run between walls and buildings
+    auto groundZ = [&](float x, float y)
+    {
+        float z = vmgr->getHeight(mapId, x, y, 1000.f, 2000.f);
+        return z > VMAP_INVALID_HEIGHT ? z + 2.f : 0.f;
+    };
+
+    std::vector<VMAP::LineOfSightQuery> queries;
+    queries.reserve(centers * targetsPerCenter);
+    for (uint32 c = 0; c < centers; ++c)
+    {
+        float cx = inTileX(rng), cy = inTileY(rng);
+        float cz = groundZ(cx, cy);
+        for (uint32 t = 0; t < targetsPerCenter; ++t)
+        {
+            float tx = cx + around(rng), ty = cy + around(rng);
+            queries.push_back({ tx, ty, groundZ(tx, ty), cx, cy, cz });
+        }
+    }
+
+    std::unique_ptr<bool[]> scalar(new bool[queries.size()]);
+    std::unique_ptr<bool[]> batched(new bool[queries.size()]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        VMAP::LineOfSightQuery const& q = queries[i];
+        scalar[i] = vmgr->isInLineOfSight(mapId, q.x1, q.y1, q.z1, q.x2, q.y2, q.z2, true);
+    }
+    auto scalarTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // one batch per center, as Spell::CheckTargetsLineOfSight issues them
+    start = std::chrono::steady_clock::now();
+    for (uint32 c = 0; c < centers; ++c)
+        vmgr->isInLineOfSight(mapId, &queries[c * targetsPerCenter], &batched[c * targetsPerCenter], targetsPerCenter, true);
+    auto batchedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 blocked = 0, mismatches = 0;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        blocked += scalar[i] ? 0 : 1;
+        mismatches += scalar[i] != batched[i] ? 1 : 0;
+    }
+
+    printf("%u rays, %u blocked\n", uint32(queries.size()), blocked);
+    printf("scalar:  %.2f ms\n", scalarTime);
+    printf("batched: %.2f ms (%u per batch)\n", batchedTime, targetsPerCenter);
+    printf("mismatches: %u\n", mismatches);
+
+    vmgr->unloadMap(mapId, tileX, tileY);
+    return mismatches ? 2 : 0;
+}
@@ -18,9 +18,17 @@
 
 #include "EventProcessor.h"
 
+#include <bit>
+#include <limits>
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_wheelTime = 0;
+    m_nextCheck = std::numeric_limits<uint64>::max();
+    m_count = 0;
+    m_ready = nullptr;
+    m_overflow = nullptr;
     m_aborting = false;
 }
 
@@ -34,13 +42,21 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    if (!m_count)
+        return;
+
+    // main event loop, events added meanwhile for a time up to m_time are executed in this update too
+    while (true)
     {
+        if (m_time >= m_nextCheck)
+            Advance(m_time);
+
+        BasicEvent* Event = m_ready;
+        if (!Event)
+            break;
+
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        Unlink(Event);
 
         if (!Event->to_Abort)
         {
@@ -64,38 +80,25 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    ForEachEvent([this, force](BasicEvent* event)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        event->to_Abort = true;
+        event->Abort(m_time);
+        if (force || event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+            Unlink(event);
+            delete event;
         }
-    }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    });
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    if (!event->IsScheduled())
+        return;
+
+    Unlink(event);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -103,25 +106,188 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     if (set_addtime)
         Event->m_addTime = m_time;
 
+    if (Event->IsScheduled())
+        Unlink(Event);
+
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Schedule(Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    if (!Event->IsScheduled())
+        return;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
-    }
+    Unlink(Event);
+    Event->m_execTime = msTime;
+    Schedule(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+// wheel invariant: an event at level L differs from m_wheelTime first in the L-th group of WHEEL_BITS bits,
+// where its own digit is the slot and is always above the digit of m_wheelTime
+void EventProcessor::Schedule(BasicEvent* event)
+{
+    ++m_count;
+
+    uint64 time = event->m_execTime;
+    if (time <= m_wheelTime)
+    {
+        event->m_listLevel = LIST_READY;
+        InsertSorted(m_ready, event);
+        return;
+    }
+
+    if (time < m_nextCheck)
+        m_nextCheck = time;
+
+    uint32 level = (std::bit_width(time ^ m_wheelTime) - 1) / WHEEL_BITS;
+    if (level >= WHEEL_LEVELS)
+    {
+        event->m_listLevel = LIST_OVERFLOW;
+        PushBack(m_overflow, event);
+        return;
+    }
+
+    if (!m_wheel)
+        m_wheel = std::make_unique<Wheel>();
+
+    uint32 slot = (time >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+    event->m_listLevel = uint8(level);
+    event->m_listSlot = uint8(slot);
+    PushBack(m_wheel->slots[level][slot], event);
+    m_wheel->masks[level] |= uint16(1 << slot);
+}
+
+void EventProcessor::Unlink(BasicEvent* event)
+{
+    BasicEvent*& head = GetList(event->m_listLevel, event->m_listSlot);
+    if (event->m_nextEvent == event)
+    {
+        head = nullptr;
+        if (event->m_listLevel < WHEEL_LEVELS)
+            m_wheel->masks[event->m_listLevel] &= uint16(~(1 << event->m_listSlot));
+    }
+    else
+    {
+        event->m_prevEvent->m_nextEvent = event->m_nextEvent;
+        event->m_nextEvent->m_prevEvent = event->m_prevEvent;
+        if (head == event)
+            head = event->m_nextEvent;
+    }
+
+    event->m_prevEvent = nullptr;
+    event->m_nextEvent = nullptr;
+    event->m_listLevel = LIST_NONE;
+    --m_count;
+}
+
+// moves m_wheelTime up to target, cascading every slot it passes and collecting due events in the ready list
+void EventProcessor::Advance(uint64 target)
+{
+    uint64 const topSpan = uint64(1) << (WHEEL_LEVELS * WHEEL_BITS);
+
+    while (true)
+    {
+        // lowest non empty level holds the earliest events
+        uint32 level = 0;
+        while (level < WHEEL_LEVELS && (!m_wheel || !m_wheel->masks[level]))
+            ++level;
+
+        uint64 start;
+        if (level < WHEEL_LEVELS)
+        {
+            uint32 shift = (level + 1) * WHEEL_BITS;
+            uint32 slot = std::countr_zero(m_wheel->masks[level]);
+            start = ((m_wheelTime >> shift) << shift) | (uint64(slot) << (level * WHEEL_BITS));
+        }
+        else if (m_overflow)
+            start = (m_wheelTime & ~(topSpan - 1)) + topSpan;
+        else
+            start = std::numeric_limits<uint64>::max();
+
+        if (start > target)
+        {
+            // nothing before target, jumping there keeps the invariant
+            m_wheelTime = target;
+            m_nextCheck = start;
+            return;
+        }
+
+        m_wheelTime = start;
+
+        BasicEvent*& list = level < WHEEL_LEVELS ? m_wheel->slots[level][std::countr_zero(m_wheel->masks[level])] : m_overflow;
+        BasicEvent* head = list;
+        list = nullptr;
+        if (level < WHEEL_LEVELS)
+            m_wheel->masks[level] &= uint16(~(1 << head->m_listSlot));
+
+        // reschedule detached events, they land in lower levels or in the ready list
+        BasicEvent* event = head;
+        head->m_prevEvent->m_nextEvent = nullptr;
+        while (event)
+        {
+            BasicEvent* next = event->m_nextEvent;
+            --m_count;                                      // Schedule counts it again
+            Schedule(event);
+            event = next;
+        }
+    }
+}
+
+BasicEvent*& EventProcessor::GetList(uint8 level, uint8 slot)
+{
+    if (level == LIST_READY)
+        return m_ready;
+    if (level == LIST_OVERFLOW)
+        return m_overflow;
+    return m_wheel->slots[level][slot];
+}
+
+void EventProcessor::PushBack(BasicEvent*& head, BasicEvent* event)
+{
+    if (!head)
+    {
+        event->m_prevEvent = event;
+        event->m_nextEvent = event;
+        head = event;
+        return;
+    }
+
+    BasicEvent* tail = head->m_prevEvent;
+    event->m_prevEvent = tail;
+    event->m_nextEvent = head;
+    tail->m_nextEvent = event;
+    head->m_prevEvent = event;
+}
+
+// equal times keep insertion order, cascades append in time order so the search from the tail is short
+void EventProcessor::InsertSorted(BasicEvent*& head, BasicEvent* event)
+{
+    if (!head || head->m_prevEvent->m_execTime <= event->m_execTime)
+    {
+        PushBack(head, event);
+        return;
+    }
+
+    BasicEvent* after = head->m_prevEvent;
+    while (after != head && after->m_execTime > event->m_execTime)
+        after = after->m_prevEvent;
+
+    if (after->m_execTime > event->m_execTime)
+    {
+        // before the current head, which is the tail position of the circular list
+        PushBack(head, event);
+        head = event;
+        return;
+    }
+
+    event->m_prevEvent = after;
+    event->m_nextEvent = after->m_nextEvent;
+    after->m_nextEvent->m_prevEvent = event;
+    after->m_nextEvent = event;
+}
@@ -21,16 +21,20 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <memory>
 
 // Note. All times are in milliseconds here.
 
+class EventProcessor;
+
 class BasicEvent
 {
+        friend class EventProcessor;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_prevEvent(nullptr), m_nextEvent(nullptr), m_listLevel(0xFF), m_listSlot(0)
         {
         }
 
@@ -47,16 +51,25 @@ class BasicEvent
 
         virtual void Abort(uint64 /*e_time*/) {}            // this method executes when the event is aborted
 
+        bool IsScheduled() const { return m_listLevel != 0xFF; }
+
         bool to_Abort;                                      // set by externals when the event is aborted, aborted events don't execute
         // and get Abort call when deleted
 
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        // intrusive hooks of the event processor, an event is in at most one of its lists
+        BasicEvent* m_prevEvent;
+        BasicEvent* m_nextEvent;
+        uint8 m_listLevel;                                  // wheel level, overflow or ready list, 0xFF if not scheduled
+        uint8 m_listSlot;
+};
 
+// hierarchical timing wheel, schedule, kill and reschedule are O(1)
+// events due in one update are executed in m_execTime order, same as a sorted queue would
 class EventProcessor
 {
     public:
@@ -70,13 +83,71 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void ModifyEventTime(BasicEvent* event, uint64 msTime);
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
-        bool IsEmpty() const { return m_events.empty(); }
+        bool IsEmpty() const { return m_count == 0; }
+        uint32 GetCount() const { return m_count; }
+
+        // callback may not remove other events than the visited one
+        template<typename F> void ForEachEvent(F&& func)
+        {
+            ForEachIn(m_ready, func);
+            ForEachIn(m_overflow, func);
+            if (m_wheel)
+                for (auto& level : m_wheel->slots)
+                    for (BasicEvent* slot : level)
+                        ForEachIn(slot, func);
+        }
 
     protected:
 
+        static uint32 const WHEEL_BITS   = 4;
+        static uint32 const WHEEL_SLOTS  = 1 << WHEEL_BITS;
+        static uint32 const WHEEL_LEVELS = 5;               // 2^20 ms, about 17 minutes, later events wait in overflow list
+
+        static uint8 const LIST_OVERFLOW = WHEEL_LEVELS;
+        static uint8 const LIST_READY    = WHEEL_LEVELS + 1;
+        static uint8 const LIST_NONE     = 0xFF;
+
+        struct Wheel
+        {
+            Wheel() : slots(), masks() {}
+
+            BasicEvent* slots[WHEEL_LEVELS][WHEEL_SLOTS];   // circular lists, head pointers only
+            uint16 masks[WHEEL_LEVELS];                     // non empty slots
+        };
+
+        void Schedule(BasicEvent* event);
+        void Unlink(BasicEvent* event);
+        void Advance(uint64 target);
+        BasicEvent*& GetList(uint8 level, uint8 slot);
+
+        static void PushBack(BasicEvent*& head, BasicEvent* event);
+        static void InsertSorted(BasicEvent*& head, BasicEvent* event);
+
+        template<typename F> static void ForEachIn(BasicEvent* head, F& func)
+        {
+            if (!head)
+                return;
+
+            BasicEvent* event = head;
+            BasicEvent* last = head->m_prevEvent;
+            while (true)
+            {
+                BasicEvent* next = event->m_nextEvent;
+                bool isLast = event == last;
+                func(event);
+                if (isLast)
+                    break;
+                event = next;
+            }
+        }
+
         uint64 m_time;
-        EventList m_events;
+        uint64 m_wheelTime;                                 // every event at or before it is in the ready list
+        uint64 m_nextCheck;                                 // no wheel work needed before this time
+        uint32 m_count;
+        BasicEvent* m_ready;                                // due events, sorted by execution time
+        BasicEvent* m_overflow;
+        std::unique_ptr<Wheel> m_wheel;                     // allocated on first use, many objects never schedule anything
         bool m_aborting;
 };
 
@@ -306,15 +306,20 @@ struct spell_explosive_barrage_aura : public AuraScript
             return;
 
         // Summon an Exploding Orb for each player in combat with the caster
+        // the casts may change the threat list, so collect the players first
+        std::vector<Unit*> players;
         ThreatList const& threatList = target->getThreatManager().getThreatList();
         for (auto itr : threatList)
         {
             if (Unit* expectedTarget = target->GetMap()->GetUnit(itr->getUnitGuid()))
             {
                 if (expectedTarget->IsPlayer())
-                    target->CastSpell(expectedTarget, 69015, TRIGGERED_OLD_TRIGGERED);
+                    players.push_back(expectedTarget);
             }
         }
+
+        for (Unit* player : players)
+            target->CastSpell(player, 69015, TRIGGERED_OLD_TRIGGERED);
     }
 };
 
@@ -462,7 +462,7 @@ bool AchievementCriteriaRequirementSet::Meets(Player const* source, Unit const*
     return true;
 }
 
-AchievementMgr::AchievementMgr(Player* player)
+AchievementMgr::AchievementMgr(Player* player) : m_completedCriteria(sAchievementCriteriaStore.GetNumRows(), false)
 {
     m_player = player;
 }
@@ -489,6 +489,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_completedCriteria.assign(m_completedCriteria.size(), false);
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -529,6 +530,7 @@ void AchievementMgr::StartAchievementCriteria(CriteriaStartEvent startEvent, uin
 
         progress->changed = true;
         progress->counter = 0;
+        UpdateCompletedCriteria(achievementCriteria, achievement);
 
         TimePoint now = GetPlayer()->GetMap()->GetCurrentClockTime();
 
@@ -718,6 +720,8 @@ void AchievementMgr::LoadFromDB(std::unique_ptr<QueryResult> achievementResult,
                     progress.changed = true;
                 }
             }
+
+            UpdateCompletedCriteria(criteria, achievement);
         }
         while (criteriaResult->NextRow());
     }
@@ -860,6 +864,7 @@ void AchievementMgr::StartTimedAchievementCriteria(CriteriaTimedEvent timedEvent
 
         progress->changed = true;
         progress->counter = 0;
+        UpdateCompletedCriteria(achievementCriteria, achievement);
 
         TimePoint now = GetPlayer()->GetMap()->GetCurrentClockTime();
 
@@ -912,6 +917,7 @@ void AchievementMgr::DoFailedTimedAchievementCriterias()
 
             // Remove failed progress
             m_criteriaProgress.erase(pro_iter);
+            UpdateCompletedCriteria(criteria, achievement);
         }
 
         m_criteriaFailTimes.erase(iter++);
@@ -928,18 +934,15 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryVector const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    // faction and asset (miscvalue1) are already matched by the index
+    AchievementCriteriaEntryVector const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaForUpdate(type, miscvalue1, GetPlayer()->GetTeam());
     for (auto achievementCriteria : achievementCriteriaList)
     {
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         // Checked in LoadAchievementCriteriaList
 
-        if ((achievement->factionFlag == ACHIEVEMENT_FACTION_FLAG_HORDE && GetPlayer()->GetTeam() != HORDE) ||
-                (achievement->factionFlag == ACHIEVEMENT_FACTION_FLAG_ALLIANCE && GetPlayer()->GetTeam() != ALLIANCE))
-            continue;
-
         // don't update already completed criteria
-        if (IsCompletedCriteria(achievementCriteria, achievement))
+        if (HasCompletedCriteria(achievementCriteria, achievement))
             continue;
 
         if (achievementCriteria->startEvent) // if has start event, must already exist
@@ -2094,6 +2097,23 @@ bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achieve
     return progress->counter >= maxcounter || (achievement->flags & ACHIEVEMENT_FLAG_REQ_COUNT && progress->counter);
 }
 
+bool AchievementMgr::HasCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement) const
+{
+    if (achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
+        return IsCompletedCriteria(achievementCriteria, achievement);
+
+    return achievementCriteria->ID < m_completedCriteria.size() && m_completedCriteria[achievementCriteria->ID];
+}
+
+void AchievementMgr::UpdateCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement)
+{
+    if (achievementCriteria->ID >= m_completedCriteria.size())
+        return;
+
+    m_completedCriteria[achievementCriteria->ID] = !(achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL)) &&
+        IsCompletedCriteria(achievementCriteria, achievement);
+}
+
 void AchievementMgr::CompletedCriteriaFor(AchievementEntry const* achievement)
 {
     // counter can never complete
@@ -2237,6 +2257,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
 
     progress->counter = newValue;
     progress->changed = true;
+    UpdateCompletedCriteria(criteria, achievement);
 
     // update client side value
     SendCriteriaUpdate(criteria->ID, progress);
@@ -2456,6 +2477,64 @@ AchievementCriteriaEntryVector const& AchievementGlobalMgr::GetAchievementCriter
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryVector const& AchievementGlobalMgr::GetAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint32 asset, Team team) const
+{
+    PvpTeamIndex teamIndex = GetTeamIndexByTeamId(team);
+
+    // asset 0 is used for updates at login, those check all criteria of the type
+    if (asset && IsCriteriaTypeKeyedByAsset(type))
+    {
+        static AchievementCriteriaEntryVector const emptyList;
+
+        AchievementCriteriaListByAsset::const_iterator itr = m_AchievementCriteriasByAsset[teamIndex][type].find(asset);
+        return itr != m_AchievementCriteriasByAsset[teamIndex][type].end() ? itr->second : emptyList;
+    }
+
+    return m_AchievementCriteriasByTypeAndTeam[teamIndex][type];
+}
+
+/**
+ * Types for which UpdateAchievementCriteria skips every criteria whose asset (first dbc value) differs from a non zero miscvalue1.
+ * Keep in sync with the switch there, a type listed here that accepts other criteria would lose updates.
+ */
+bool AchievementGlobalMgr::IsCriteriaTypeKeyedByAsset(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 AchievementCriteriaEntryVector const& AchievementGlobalMgr::GetAchievementCriteriaByFailEvent(CriteriaFailEvent failEvent) const
 {
     return m_achievementCriteriaByFailEvent[uint8(failEvent)];
@@ -2553,6 +2632,17 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         }
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+
+        for (uint8 teamIndex = 0; teamIndex < PVP_TEAM_COUNT; ++teamIndex)
+        {
+            if ((achiev->factionFlag == ACHIEVEMENT_FACTION_FLAG_HORDE && teamIndex != TEAM_INDEX_HORDE) ||
+                    (achiev->factionFlag == ACHIEVEMENT_FACTION_FLAG_ALLIANCE && teamIndex != TEAM_INDEX_ALLIANCE))
+                continue;
+
+            m_AchievementCriteriasByTypeAndTeam[teamIndex][criteria->requiredType].push_back(criteria);
+            if (IsCriteriaTypeKeyedByAsset(AchievementCriteriaTypes(criteria->requiredType)))
+                m_AchievementCriteriasByAsset[teamIndex][criteria->requiredType][criteria->raw.value].push_back(criteria);
+        }
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
         if (criteria->failEvent != 0)
             m_achievementCriteriaByFailEvent[criteria->failEvent].push_back(criteria);
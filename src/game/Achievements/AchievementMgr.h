@@ -27,6 +27,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 struct AchievementEntry;
 struct AchievementCriteriaEntry;
@@ -35,6 +37,7 @@ typedef std::vector<AchievementCriteriaEntry const*> AchievementCriteriaEntryVec
 typedef std::list<AchievementEntry const*>           AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryVector> AchievementCriteriaListByAchievement;
+typedef std::unordered_map<uint32, AchievementCriteriaEntryVector> AchievementCriteriaListByAsset;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
 typedef std::map<uint32, TimePoint>                    AchievementCriteriaFailTimeMap;
 
@@ -336,10 +339,17 @@ class AchievementMgr
         bool IsCompletedAchievement(AchievementEntry const* entry);
         void BuildAllDataPacket(WorldPacket& data);
 
+        // same as IsCompletedCriteria, answered from m_completedCriteria where possible
+        bool HasCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement) const;
+        // must be called whenever the progress of the criteria changes or is removed
+        void UpdateCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement);
+
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
+        // completed criteria by criteria id, realm first criteria depend on other players and are always checked in full
+        std::vector<bool> m_completedCriteria;
 };
 
 class AchievementGlobalMgr
@@ -348,6 +358,8 @@ class AchievementGlobalMgr
         ~AchievementGlobalMgr();
 
         AchievementCriteriaEntryVector const& GetAchievementCriteriaByType(AchievementCriteriaTypes type) const;
+        // criteria that an event of the type can advance for the team, narrowed down to the asset (creature, item, quest...) if the type is keyed by it
+        AchievementCriteriaEntryVector const& GetAchievementCriteriaForUpdate(AchievementCriteriaTypes type, uint32 asset, Team team) const;
         AchievementCriteriaEntryVector const& GetAchievementCriteriaByFailEvent(CriteriaFailEvent failEvent) const;
         AchievementCriteriaEntryVector const& GetAchievementCriteriaByStartEvent(CriteriaStartEvent startEvent) const;
         AchievementCriteriaEntryVector const& GetAchievementCriteriaByTimedEvent(CriteriaTimedEvent timedEvent) const;
@@ -380,8 +392,14 @@ class AchievementGlobalMgr
     private:
         AchievementCriteriaRequirementMap m_criteriaRequirementMap;
 
+        static bool IsCriteriaTypeKeyedByAsset(AchievementCriteriaTypes type);
+
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryVector m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // same by team, achievements of the other faction left out
+        AchievementCriteriaEntryVector m_AchievementCriteriasByTypeAndTeam[PVP_TEAM_COUNT][ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // store criterias of asset keyed types by team and asset, events only touch criteria they can advance
+        AchievementCriteriaListByAsset m_AchievementCriteriasByAsset[PVP_TEAM_COUNT][ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
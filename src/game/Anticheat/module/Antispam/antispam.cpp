@@ -260,7 +260,7 @@ std::string Antispam::GetInfo() const
         ret << "Repeats: " << u.first << " Message: \"" << u.second << "\"";
 
         if (i > 0)
-            ret << " Distance from previous message: " << nam::damerau_levenshtein_distance(_uniqueMessages[i - 1].second, u.second);
+            ret << " Distance from previous message: " << nam::damerau_levenshtein_matcher(_uniqueMessages[i - 1].second).distance(u.second);
 
         ret << "\n";
     }
@@ -517,18 +517,23 @@ void Antispam::Analyze()
     }
 
     // step 5: see if they are repeating their messages too often
+    auto const uniquenessThreshold = sAnticheatConfig.GetAntispamUniquenessThreshold();
     for (auto const &msg : messages)
     {
+        // the message is compared against every unique message, so preprocess it only once
+        nam::damerau_levenshtein_matcher const matcher(msg);
+
         // first see if the message is similar to previously observed unique messages
         bool found = false;
         for (auto i = 0u; i < _uniqueMessages.size(); ++i)
         {
             auto &u = _uniqueMessages[i];
 
-            auto const distance = static_cast<uint32>(nam::damerau_levenshtein_distance(msg, u.second));
+            // only whether the distance is below the threshold matters, so the comparison may stop early
+            auto const distance = matcher.distance(u.second, uniquenessThreshold);
 
             // if these two messages are the same, increase the count
-            if (distance < sAnticheatConfig.GetAntispamUniquenessThreshold())
+            if (distance < uniquenessThreshold)
             {
                 ++u.first;
                 found = true;
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <regex>
 #include <algorithm>
@@ -56,7 +57,7 @@ namespace NamreebAnticheat
 {
 std::string AntispamMgr::NormalizeString(const std::string &string, uint32 mask) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_mutex);
     return NormalizeStringInternal(string, mask);
 }
 
@@ -137,15 +138,26 @@ std::string AntispamMgr::NormalizeStringInternal(const std::string &string, uint
     return newMsg;
 }
 
-AntispamMgr::AntispamMgr() : _shutdownRequested(false), _worker(&AntispamMgr::WorkerLoop, this) {}
+AntispamMgr::AntispamMgr() : _shutdownRequested(false)
+{
+    // the thread count is read once, changing it requires a restart
+    auto const threads = std::max(1u, sAnticheatConfig.GetAntispamWorkerThreads());
+
+    _workQueues.resize(threads);
+
+    for (auto i = 0u; i < threads; ++i)
+        _workers.emplace_back(&AntispamMgr::WorkerLoop, this, i);
+}
 
 AntispamMgr::~AntispamMgr()
 {
     _shutdownRequested = true;
-    _worker.join();
+
+    for (auto &worker : _workers)
+        worker.join();
 }
 
-void AntispamMgr::WorkerLoop()
+void AntispamMgr::WorkerLoop(size_t shard)
 {
     while (!_shutdownRequested)
     {
@@ -161,15 +173,19 @@ void AntispamMgr::WorkerLoop()
 
             // lock the mutex only long enough to move the work queue to a local container and expire old blacklist history
             {
-                std::lock_guard<std::mutex> guard(_mutex);
-                workQueue = std::move(_workQueue);
+                std::lock_guard<std::shared_mutex> guard(_mutex);
+                workQueue.swap(_workQueues[shard]);
 
-                for (auto i = _temporaryCache.begin(); i != _temporaryCache.end(); )
+                // the cache is shared by all shards, the first one takes care of it
+                if (!shard)
                 {
-                    if (i->second.first + expireMS <= startMS)
-                        i = _temporaryCache.erase(i);
-                    else
-                        ++i;
+                    for (auto i = _temporaryCache.begin(); i != _temporaryCache.end(); )
+                    {
+                        if (i->second.first + expireMS <= startMS)
+                            i = _temporaryCache.erase(i);
+                        else
+                            ++i;
+                    }
                 }
             }
 
@@ -178,9 +194,11 @@ void AntispamMgr::WorkerLoop()
         }
         else
         {
-            std::lock_guard<std::mutex> guard(_mutex);
-            _workQueue.clear();
-            _temporaryCache.clear();
+            std::lock_guard<std::shared_mutex> guard(_mutex);
+            _workQueues[shard].clear();
+
+            if (!shard)
+                _temporaryCache.clear();
         }
 
         auto stop = std::chrono::high_resolution_clock::now();
@@ -198,7 +216,7 @@ void AntispamMgr::WorkerLoop()
 
 void AntispamMgr::LoadFromDB()
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::shared_mutex> guard(_mutex);
 
     auto const normMask = sAnticheatConfig.GetSpamNormalizationMask();
 
@@ -232,6 +250,8 @@ void AntispamMgr::LoadFromDB()
             _blacklist.emplace_back(entry, normEntry);
         } while (queryResult->NextRow());
 
+    BuildBlacklistMatchers();
+
     sLog.outString(">> %lu blacklist entries loaded and normalized", uint64(_blacklist.size()));
 
     queryResult = LoginDatabase.Query("SELECT `from`, `to` FROM antispam_replacement");
@@ -272,9 +292,24 @@ void AntispamMgr::LoadFromDB()
     sLog.outString(">> %lu unicode character replacements loaded", uint64(_unicodeReplace.size()));
 }
 
+void AntispamMgr::BuildBlacklistMatchers()
+{
+    _blacklistOriginal.clear();
+    _blacklistNormalized.clear();
+
+    for (auto const &entry : _blacklist)
+    {
+        _blacklistOriginal.add(entry.first);
+        _blacklistNormalized.add(entry.second);
+    }
+
+    _blacklistOriginal.build();
+    _blacklistNormalized.build();
+}
+
 void AntispamMgr::BlacklistAdd(const std::string &string_)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::shared_mutex> guard(_mutex);
 
     // cannot be empty!
     if (string_.empty())
@@ -303,68 +338,87 @@ void AntispamMgr::BlacklistAdd(const std::string &string_)
     LoginDatabase.CommitTransaction();
 
     _blacklist.emplace_back(entry, normEntry);
+
+    BuildBlacklistMatchers();
 }
 
 uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_mutex);
 
     auto const normalizationMask = sAnticheatConfig.GetSpamNormalizationMask();
     auto const msg = NormalizeStringInternal(string, normalizationMask);
 
-    std::stringstream logstr;
-    logstr << "Original message:\n" << string << "\nNormalized message:\n" << msg << "\nBlacklist violations:";
+    // violations are keyed by blacklist index * 2, plus one for the normalized form of the entry.  sorting
+    // them afterwards logs all occurrences of an entry together and in blacklist order.
+    std::vector<uint32> violations;
 
-    uint32 result = 0;
+    // occurrences of the same entry must not overlap, the same as searching again after the end of the previous one
+    std::vector<std::pair<uint32, size_t> > nextStart;
 
-    // for each entry, search the given string for multiple occurrences of both the original and normalized form of the entry
-    for (auto const& entry : _blacklist)
+    auto const addViolation = [&](uint32 key, size_t pos, size_t length)
     {
-        // search the original string for the original blacklist entry
-        if (!entry.first.empty())
-        {
-            for (auto pos = string.find(entry.first); pos != std::string::npos; pos = string.find(entry.first, pos + entry.first.length()))
-            {
-                logstr << "\nOriginal: \"" << entry.first << "\"";
-                ++result;
-            }
-        }
+        auto const i = std::find_if(nextStart.begin(), nextStart.end(), [key](auto const &n) { return n.first == key; });
 
-        // search for the normalized blacklist entry
-        if (!entry.second.empty())
+        if (i == nextStart.end())
+            nextStart.emplace_back(key, pos + length);
+        else if (pos < i->second)
+            return;
+        else
+            i->second = pos + length;
+
+        violations.push_back(key);
+    };
+
+    // search the original string for the original blacklist entries
+    _blacklistOriginal.find_all(string, [&](uint32 id, size_t pos) { addViolation(id * 2, pos, _blacklist[id].first.length()); });
+
+    // search the normalized string for the normalized blacklist entries
+    _blacklistNormalized.find_all(msg, [&](uint32 id, size_t pos) { addViolation(id * 2 + 1, pos, _blacklist[id].second.length()); });
+
+    auto const result = static_cast<uint32>(violations.size());
+
+    // if there were results found, save the log
+    if (!!result)
+    {
+        std::sort(violations.begin(), violations.end());
+
+        std::stringstream logstr;
+        logstr << "Original message:\n" << string << "\nNormalized message:\n" << msg << "\nBlacklist violations:";
+
+        for (auto const key : violations)
         {
-            for (auto pos = msg.find(entry.second); pos != std::string::npos; pos = msg.find(entry.second, pos + entry.second.length()))
-            {
+            auto const &entry = _blacklist[key / 2];
+
+            if (key & 1)
                 logstr << "\nNormalized: \"" << entry.second << "\"";
-                ++result;
-            }
+            else
+                logstr << "\nOriginal: \"" << entry.first << "\"";
         }
-    }
 
-    logstr << "\n";
+        logstr << "\n";
 
-    // if there were results found, save the log
-    if (!!result)
         log = logstr.str();
+    }
 
     return result;
 }
 
 void AntispamMgr::ScheduleAnalysis(std::shared_ptr<Antispam> session)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
-    _workQueue.insert(session);
+    std::lock_guard<std::shared_mutex> guard(_mutex);
+    _workQueues[session->GetAccount() % _workQueues.size()].insert(session);
 }
 
 void AntispamMgr::CacheSession(std::shared_ptr<Antispam> session)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::shared_mutex> guard(_mutex);
     _temporaryCache[session->GetAccount()] = std::make_pair(WorldTimer::getMSTime(), session);
 }
 
 std::shared_ptr<Antispam> AntispamMgr::GetSession(uint32 accountId)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::shared_mutex> guard(_mutex);
     
     auto const i = _temporaryCache.find(accountId);
 
@@ -380,7 +434,7 @@ std::shared_ptr<Antispam> AntispamMgr::GetSession(uint32 accountId)
 
 std::shared_ptr<Antispam> AntispamMgr::CheckCache(uint32 accountId)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_mutex);
 
     auto const i = _temporaryCache.find(accountId);
 
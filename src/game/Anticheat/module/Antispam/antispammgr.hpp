@@ -10,10 +10,13 @@
 
 #include "Policies/Singleton.h"
 
+#include "../ahocorasick.hpp"
+
 #include <atomic>
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <thread>
@@ -29,34 +32,41 @@ class Antispam;
 class AntispamMgr
 {
     private:
-        // note that once we begin using c++17, std::shared_mutex will be much more performant
-        // here as the guarded values are seldom changed but frequently read
-        mutable std::mutex _mutex;
+        // the blacklist is seldom changed but read by every worker for every message, so readers share the lock
+        mutable std::shared_mutex _mutex;
 
         std::atomic<bool> _shutdownRequested;
 
         // this collection contains a pair of strings, the original entry and the normalized version based on current settings
         std::vector<std::pair<std::string, std::string> > _blacklist;
 
+        // automata over the original and the normalized blacklist entries, pattern ids are indices into _blacklist
+        nam::aho_corasick _blacklistOriginal;
+        nam::aho_corasick _blacklistNormalized;
+
         // NOTE: _asciiReplace and _unicodeReplace are not protected by _mutex, because it would make the code much more complicated
         // and they should never be changing once the world server has started.
 
         std::vector<std::pair<std::string, std::string> > _asciiReplace;        // replacements for ascii strings (for things like @ -> A or \/\/ -> W etc.)
         std::vector<std::pair<std::wstring, std::wstring> > _unicodeReplace;    // replacements for individual unicode characters
 
-        // set of sessions to analyze in the next tick of the antispam worker thread
-        std::unordered_set<std::shared_ptr<Antispam> > _workQueue;
+        // sets of sessions to analyze in the next tick of the antispam worker threads, sharded by account id
+        // so that the sessions of one account are always analyzed by the same thread
+        std::vector<std::unordered_set<std::shared_ptr<Antispam> > > _workQueues;
 
         // temporarily cache antispam session information in case they reconnect and resume spamming
         std::unordered_map<uint32, std::pair<uint32, std::shared_ptr<Antispam> > > _temporaryCache;
 
-        // the thread is declared after all other members to guarantee that it is initialized last
-        std::thread _worker;
+        // the threads are declared after all other members, they are started once everything else is initialized
+        std::vector<std::thread> _workers;
 
         // this function performs the actual normalization, but assumes that the mutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
-        void WorkerLoop();
+        // rebuilds the blacklist automata from _blacklist, assumes that the mutex is already locked
+        void BuildBlacklistMatchers();
+
+        void WorkerLoop(size_t shard);
 
     public:
         AntispamMgr();
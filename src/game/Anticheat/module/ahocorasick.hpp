@@ -0,0 +1,162 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// nam::aho_corasick finds every occurrence of a fixed set of byte strings in a single pass over the text.
+// the automaton is a dense transition table over the bytes which occur in the patterns, bytes which occur
+// in no pattern share one column that always leads back to the root.
+
+#ifndef __AHOCORASICK_HPP_
+#define __AHOCORASICK_HPP_
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace nam
+{
+class aho_corasick
+{
+    private:
+        static constexpr uint32_t none = 0xFFFFFFFF;
+
+        std::vector<std::string> _patterns;
+        std::vector<uint32_t> _lengths;
+
+        std::array<uint16_t, 256> _class {};    // byte -> column in _next, zero for bytes which occur in no pattern
+        uint32_t _classes = 1;
+
+        std::vector<uint32_t> _next;            // state * _classes + column -> state
+        std::vector<uint32_t> _output;          // last added pattern ending in this state
+        std::vector<uint32_t> _dictLink;        // closest proper suffix state which has output
+        std::vector<uint32_t> _samePattern;     // previous pattern with identical text
+
+    public:
+        void clear()
+        {
+            _patterns.clear();
+            _lengths.clear();
+            build();
+        }
+
+        // adds a pattern, its id is the number of patterns added before it.  empty patterns never match.
+        // build() must be called before searching again.
+        void add(const std::string &pattern)
+        {
+            _patterns.push_back(pattern);
+            _lengths.push_back(static_cast<uint32_t>(pattern.length()));
+        }
+
+        size_t size() const { return _patterns.size(); }
+
+        void build()
+        {
+            _class.fill(0);
+            _classes = 1;
+
+            for (auto const &pattern : _patterns)
+                for (auto const c : pattern)
+                    if (!_class[static_cast<uint8_t>(c)])
+                        _class[static_cast<uint8_t>(c)] = static_cast<uint16_t>(_classes++);
+
+            // state zero is the root.  while building the trie a zero transition means there is no child yet
+            _next.assign(_classes, 0);
+            _output.assign(1, none);
+            _samePattern.assign(_patterns.size(), none);
+
+            for (auto id = 0u; id < _patterns.size(); ++id)
+            {
+                if (_patterns[id].empty())
+                    continue;
+
+                uint32_t state = 0;
+                for (auto const c : _patterns[id])
+                {
+                    auto &next = _next[state * _classes + _class[static_cast<uint8_t>(c)]];
+
+                    if (!next)
+                    {
+                        next = static_cast<uint32_t>(_output.size());
+                        _output.push_back(none);
+                        _next.resize(_next.size() + _classes, 0);
+                    }
+
+                    // _next may have been reallocated, do not touch 'next' after the resize
+                    state = _next[state * _classes + _class[static_cast<uint8_t>(c)]];
+                }
+
+                _samePattern[id] = _output[state];
+                _output[state] = id;
+            }
+
+            // breadth first, so that the failure state of every state is complete before it is used.  missing
+            // transitions are replaced by the transition of the failure state, which turns the trie into a dfa
+            std::vector<uint32_t> fail(_output.size(), 0);
+            _dictLink.assign(_output.size(), none);
+
+            std::deque<uint32_t> queue;
+            for (auto c = 1u; c < _classes; ++c)
+                if (auto const child = _next[c])
+                    queue.push_back(child);
+
+            while (!queue.empty())
+            {
+                auto const state = queue.front();
+                queue.pop_front();
+
+                for (auto c = 1u; c < _classes; ++c)
+                {
+                    auto &next = _next[state * _classes + c];
+                    auto const fallback = _next[fail[state] * _classes + c];
+
+                    if (!next)
+                    {
+                        next = fallback;
+                        continue;
+                    }
+
+                    fail[next] = fallback;
+                    _dictLink[next] = _output[fallback] != none ? fallback : _dictLink[fallback];
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        // calls callback(id, position) for every occurrence of every pattern in text, including overlapping ones.
+        // occurrences are reported in order of their end position.
+        template <typename Callback>
+        void find_all(const std::string &text, Callback &&callback) const
+        {
+            if (_patterns.empty())
+                return;
+
+            uint32_t state = 0;
+            for (auto i = 0u; i < text.length(); ++i)
+            {
+                state = _next[state * _classes + _class[static_cast<uint8_t>(text[i])]];
+
+                for (auto match = _output[state] != none ? state : _dictLink[state]; match != none; match = _dictLink[match])
+                    for (auto id = _output[match]; id != none; id = _samePattern[id])
+                        callback(id, i + 1 - _lengths[id]);
+            }
+        }
+};
+}
+
+#endif /* !__AHOCORASICK_HPP_ */
@@ -16,6 +16,7 @@ enum AnticheatConfigUInt32Values
     CONFIG_UINT32_AC_ANTISPAM_MAX_LEVEL = 0,
     CONFIG_UINT32_AC_ANTISPAM_NORMALIZE_MASK,
     CONFIG_UINT32_AC_ANTISPAM_ANALYSIS_TIMER,
+    CONFIG_UINT32_AC_ANTISPAM_WORKER_THREADS,
     CONFIG_UINT32_AC_ANTISPAM_MAX_RATE,
     CONFIG_UINT32_AC_ANTISPAM_RATE_GRACE_PERIOD,
     CONFIG_UINT32_AC_ANTISPAM_MAX_UNIQUE_PERCENTAGE,
@@ -144,6 +145,7 @@ class AnticheatConfig : public Config
         bool EnableAntispamSilence()                    const { return getConfig(CONFIG_BOOL_AC_ANTISPAM_SILENCE);                          }
         uint32 GetSpamNormalizationMask()               const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_NORMALIZE_MASK);                 }
         uint32 GetAntispamAnalysisTimer()               const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_ANALYSIS_TIMER);                 }
+        uint32 GetAntispamWorkerThreads()               const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_WORKER_THREADS);                 }
         uint32 GetAntispamMaxLevel()                    const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_LEVEL);                      }
         uint32 GetAntispamMaxRate()                     const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_RATE);                       }
         uint32 GetAntispamMaxUniquePercentage()         const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_MAX_UNIQUE_PERCENTAGE);          }
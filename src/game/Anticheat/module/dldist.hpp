@@ -28,6 +28,8 @@
 
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace nam
@@ -94,5 +96,99 @@ int damerau_levenshtein_distance(const std::string &string1, const std::string &
 
     return dist[get_index(columns, static_cast<int>(string1_length), static_cast<int>(string2_length))];
 }
+
+// bit-parallel version of the distance above (Hyyro 2003, optimal string alignment).  the pattern is
+// preprocessed once and can then be compared against many strings, each column of the dynamic programming
+// matrix is computed 64 rows at a time.
+class damerau_levenshtein_matcher
+{
+    private:
+        size_t _length;
+        size_t _words;
+        std::vector<uint64_t> _peq;     // 256 * _words, bit i is set when pattern[i] is the given byte
+
+    public:
+        explicit damerau_levenshtein_matcher(const std::string &pattern) :
+            _length(pattern.length()), _words((pattern.length() + 63) / 64), _peq(256 * _words, 0)
+        {
+            for (auto i = 0u; i < _length; ++i)
+                _peq[static_cast<uint8_t>(pattern[i]) * _words + i / 64] |= uint64_t(1) << (i % 64);
+        }
+
+        // returns the exact distance when it is less than bound, otherwise some value which is at least bound
+        uint32_t distance(const std::string &text, uint32_t bound = std::numeric_limits<uint32_t>::max()) const
+        {
+            auto const length = text.length();
+
+            if (!_length || !length)
+                return static_cast<uint32_t>(_length + length);
+
+            // the distance is at least the difference in length
+            auto const lengthDiff = static_cast<uint32_t>(_length > length ? _length - length : length - _length);
+            if (lengthDiff >= bound)
+                return lengthDiff;
+
+            std::vector<uint64_t> vp(_words, ~uint64_t(0)), vn(_words, 0), d0(_words, 0);
+
+            auto const last = _words - 1;
+            auto const lastBit = uint64_t(1) << ((_length - 1) % 64);
+            auto score = static_cast<uint32_t>(_length);
+            const uint64_t *prevEq = nullptr;
+
+            for (auto j = 0u; j < length; ++j)
+            {
+                auto const eq = &_peq[static_cast<uint8_t>(text[j]) * _words];
+
+                // carries between the words of the bit vectors
+                uint64_t trCarry = 0, addCarry = 0, hpCarry = 1, hnCarry = 0;
+
+                for (auto w = 0u; w < _words; ++w)
+                {
+                    auto const x = eq[w];
+                    auto const vpw = vp[w];
+                    auto const vnw = vn[w];
+
+                    auto const trans = (~d0[w]) & x;
+                    auto const tr = ((trans << 1) | trCarry) & (prevEq ? prevEq[w] : 0);
+                    trCarry = trans >> 63;
+
+                    auto const masked = x & vpw;
+                    auto const sum = masked + vpw;
+                    auto const total = sum + addCarry;
+                    addCarry = (sum < masked || total < sum) ? 1 : 0;
+
+                    auto const d = (total ^ vpw) | x | vnw | tr;
+                    auto const hp = vnw | ~(d | vpw);
+                    auto const hn = d & vpw;
+
+                    if (w == last)
+                    {
+                        if (hp & lastBit)
+                            ++score;
+                        else if (hn & lastBit)
+                            --score;
+                    }
+
+                    auto const hps = (hp << 1) | hpCarry;
+                    auto const hns = (hn << 1) | hnCarry;
+                    hpCarry = hp >> 63;
+                    hnCarry = hn >> 63;
+
+                    vn[w] = hps & d;
+                    vp[w] = hns | ~(hps | d);
+                    d0[w] = d;
+                }
+
+                prevEq = eq;
+
+                // every remaining column can lower the score by at most one
+                auto const remaining = static_cast<uint32_t>(length - j - 1);
+                if (score >= remaining && score - remaining >= bound)
+                    return score - remaining;
+            }
+
+            return score;
+        }
+};
 }
 #endif /* !__DLDIST_HPP_ */
\ No newline at end of file
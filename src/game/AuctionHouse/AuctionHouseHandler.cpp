@@ -651,16 +651,40 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
-    std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
+    // converting string that we try to find to lower case
+    std::wstring wsearchedname;
+    if (!Utf8toWStr(searchedname, wsearchedname))
+        return;
+
+    wstrToLower(wsearchedname);
+
+    // full scan requests ignore all filters
+    AuctionSearchFilter filter;
+    if (!isFull)
+    {
+        filter.name = wsearchedname;
+        filter.levelmin = levelmin;
+        filter.levelmax = levelmax;
+        filter.inventoryType = auctionSlotID;
+        filter.itemClass = auctionMainCategory;
+        filter.itemSubClass = auctionSubCategory;
+        filter.quality = quality;
+        filter.locale = GetSessionDbLocaleIndex();
+    }
 
-    for (const auto& auc : aucs)
-        auctions.push_back(auc.second);
+    std::vector<AuctionEntry*> auctions;
+    auctionHouse->SearchAuctions(filter, auctions);
 
-    AuctionSorter sorter(Sort, GetPlayer());
-    std::sort(auctions.begin(), auctions.end(), sorter);
+    // Sort, without usable check every match is listed so only the requested page has to be ordered
+    if (sortCount)
+    {
+        AuctionSorter sorter(Sort, GetPlayer());
+        size_t pageEnd = size_t(listfrom) + MAX_AUCTION_ITEMS_CLIENT_UI_PAGE;
+        if (!isFull && !usable && pageEnd < auctions.size())
+            std::partial_sort(auctions.begin(), auctions.begin() + pageEnd, auctions.end(), sorter);
+        else
+            std::sort(auctions.begin(), auctions.end(), sorter);
+    }
 
     // DEBUG_LOG("Auctionhouse search %s list from: %u, searchedname: %s, levelmin: %u, levelmax: %u, auctionSlotID: %u, auctionMainCategory: %u, auctionSubCategory: %u, quality: %u, usable: %u",
     //  auctioneerGuid.GetString().c_str(), listfrom, searchedname.c_str(), levelmin, levelmax, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, usable);
@@ -670,15 +694,7 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     uint32 totalcount = 0;
     data << uint32(0);
 
-    // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(searchedname, wsearchedname))
-        return;
-
-    wstrToLower(wsearchedname);
-
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-                          auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull != 0);
+    BuildListAuctionItems(auctions, data, listfrom, usable, count, totalcount, isFull != 0);
 
     data.put<uint32>(0, count);
     data << uint32(totalcount);
@@ -571,6 +571,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
+                RemoveFromSearchIndex(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
                 continue;
@@ -589,6 +590,7 @@ void AuctionHouseObject::Update()
                     sAuctionMgr.SendAuctionExpiredMail(itr->second);
 
                     itr->second->DeleteFromDB();
+                    RemoveFromSearchIndex(itr->second);
                     delete itr->second;
                     AuctionsMap.erase(itr++);
                     continue;
@@ -800,19 +802,11 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-        uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const
+void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, uint32 listfrom, uint32 usable,
+        uint32& count, uint32& totalcount, bool isFull) const
 {
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
-
     for (auto Aentry : auctions)
     {
-        if (Aentry->moneyDeliveryTime)
-            continue;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
-
         if (isFull)
         {
             ++count;
@@ -820,36 +814,16 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
         }
         else
         {
-            ItemPrototype const* proto = item->GetProto();
-
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
-
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
-
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+            if (usable != 0x00)
             {
-                if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                {
-                    // if inventory type is chest, we want to return robes too
-                    // i.e. cloth chests are in most cases robes by definition
-
+                Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+                if (!item)
                     continue;
-                }
-            }
-
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-                continue;
-
-            if (usable != 0x00)
-            {
                 if (_player->CanUseItem(item) != EQUIP_ERR_OK)
                     continue;
 
+                ItemPrototype const* proto = item->GetProto();
                 if (proto->Class == ITEM_CLASS_RECIPE)
                 {
                     if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
@@ -860,12 +834,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 }
             }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
-
             if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
             {
                 ++count;
@@ -877,6 +845,180 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
     }
 }
 
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    m_indexByClass[proto->Class << 16 | proto->SubClass][auction->Id] = auction;
+    m_indexByInventoryType[proto->InventoryType][auction->Id] = auction;
+    m_indexByQuality[proto->Quality][auction->Id] = auction;
+    m_indexByLevel[proto->RequiredLevel][auction->Id] = auction;
+
+    AuctionEntryMap& byTemplate = m_indexByTemplate[auction->itemTemplate];
+    if (byTemplate.empty())
+        sAuctionMgr.GetItemSearchName(auction->itemTemplate, -1);   // default locale is prebuilt, others on first search
+    byTemplate[auction->Id] = auction;
+}
+
+void AuctionHouseObject::RemoveFromSearchIndex(AuctionEntry* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    auto removeFrom = [auction](AuctionIndex& index, uint32 key)
+    {
+        AuctionIndex::iterator itr = index.find(key);
+        if (itr == index.end())
+            return;
+
+        itr->second.erase(auction->Id);
+        if (itr->second.empty())
+            index.erase(itr);
+    };
+
+    removeFrom(m_indexByClass, proto->Class << 16 | proto->SubClass);
+    removeFrom(m_indexByInventoryType, proto->InventoryType);
+    removeFrom(m_indexByQuality, proto->Quality);
+    removeFrom(m_indexByLevel, proto->RequiredLevel);
+    removeFrom(m_indexByTemplate, auction->itemTemplate);
+}
+
+size_t AuctionHouseObject::CollectBuckets(AuctionIndex const& index, uint32 lowKey, uint32 highKey, AuctionIndexBuckets& buckets)
+{
+    size_t size = 0;
+    for (AuctionIndex::const_iterator itr = index.lower_bound(lowKey); itr != index.end() && itr->first <= highKey; ++itr)
+    {
+        buckets.push_back(&itr->second);
+        size += itr->second.size();
+    }
+    return size;
+}
+
+void AuctionHouseObject::SearchAuctions(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& result) const
+{
+    // walk only the most selective index, the other conditions are cheap template checks per candidate
+    AuctionIndexBuckets driver(1, &AuctionsMap);
+    size_t driverSize = AuctionsMap.size();
+
+    AuctionIndexBuckets buckets;
+    auto consider = [&](size_t size)
+    {
+        if (size < driverSize)
+        {
+            driverSize = size;
+            driver.swap(buckets);
+        }
+        buckets.clear();
+    };
+
+    if (filter.itemClass != 0xffffffff)
+    {
+        uint32 lowKey = filter.itemClass << 16 | (filter.itemSubClass != 0xffffffff ? filter.itemSubClass : 0);
+        uint32 highKey = filter.itemClass << 16 | (filter.itemSubClass != 0xffffffff ? filter.itemSubClass : 0xFFFF);
+        consider(CollectBuckets(m_indexByClass, lowKey, highKey, buckets));
+    }
+
+    if (filter.inventoryType != 0xffffffff)
+    {
+        size_t size = CollectBuckets(m_indexByInventoryType, filter.inventoryType, filter.inventoryType, buckets);
+        // if inventory type is chest, we want to return robes too
+        if (filter.inventoryType == INVTYPE_CHEST)
+            size += CollectBuckets(m_indexByInventoryType, INVTYPE_ROBE, INVTYPE_ROBE, buckets);
+        consider(size);
+    }
+
+    if (filter.quality != 0xffffffff)
+        consider(CollectBuckets(m_indexByQuality, filter.quality, 0xffffffff, buckets));
+
+    if (filter.levelmin != 0x00)
+        consider(CollectBuckets(m_indexByLevel, filter.levelmin, filter.levelmax != 0x00 ? filter.levelmax : 0xffffffff, buckets));
+
+    if (!filter.name.empty())
+    {
+        size_t size = 0;
+        for (AuctionIndex::const_iterator itr = m_indexByTemplate.begin(); itr != m_indexByTemplate.end(); ++itr)
+        {
+            if (sAuctionMgr.GetItemSearchName(itr->first, filter.locale).find(filter.name) == std::wstring::npos)
+                continue;
+
+            buckets.push_back(&itr->second);
+            size += itr->second.size();
+        }
+        consider(size);
+    }
+
+    result.reserve(driverSize);
+
+    for (AuctionEntryMap const* bucket : driver)
+    {
+        for (AuctionEntryMap::const_iterator itr = bucket->begin(); itr != bucket->end(); ++itr)
+        {
+            AuctionEntry* Aentry = itr->second;
+            if (Aentry->moneyDeliveryTime)
+                continue;
+
+            if (!sAuctionMgr.GetAItem(Aentry->itemGuidLow))
+                continue;
+
+            ItemPrototype const* proto = ObjectMgr::GetItemPrototype(Aentry->itemTemplate);
+            if (!proto)
+                continue;
+
+            if (filter.itemClass != 0xffffffff && proto->Class != filter.itemClass)
+                continue;
+
+            if (filter.itemSubClass != 0xffffffff && proto->SubClass != filter.itemSubClass)
+                continue;
+
+            if (filter.inventoryType != 0xffffffff && proto->InventoryType != filter.inventoryType)
+            {
+                if (filter.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+                    continue;
+            }
+
+            if (filter.quality != 0xffffffff && proto->Quality < filter.quality)
+                continue;
+
+            if (filter.levelmin != 0x00 && (proto->RequiredLevel < filter.levelmin || (filter.levelmax != 0x00 && proto->RequiredLevel > filter.levelmax)))
+                continue;
+
+            if (!filter.name.empty() && sAuctionMgr.GetItemSearchName(Aentry->itemTemplate, filter.locale).find(filter.name) == std::wstring::npos)
+                continue;
+
+            result.push_back(Aentry);
+        }
+    }
+
+    // every bucket is id ordered on its own, a range of them has to be merged back
+    if (driver.size() > 1)
+        std::sort(result.begin(), result.end(), [](AuctionEntry const* left, AuctionEntry const* right) { return left->Id < right->Id; });
+}
+
+std::wstring const& AuctionHouseMgr::GetItemSearchName(uint32 itemEntry, int locale)
+{
+    ItemSearchNameMap& names = mItemSearchNames[locale];
+    auto inserted = names.try_emplace(itemEntry);
+    std::wstring& wname = inserted.first->second;
+    if (!inserted.second)
+        return wname;
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itemEntry))
+    {
+        std::string name = proto->Name1;
+        sObjectMgr.GetItemLocaleStrings(itemEntry, locale, &name);
+
+        if (Utf8toWStr(name, wname))
+            wstrToLower(wname);
+        else
+            wname.clear();
+    }
+
+    return wname;
+}
+
 void AuctionHouseObject::BuildListPendingSales(WorldPacket& data, Player* player, uint32& count)
 {
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -87,6 +87,21 @@ struct AuctionEntry
     bool UpdateBid(uint32 newbid, Player* newbidder = nullptr);// true if normal bid, false if buyout, bidder==nullptr for generated bid
 };
 
+// static part of CMSG_AUCTION_LIST_ITEMS, everything that can be answered from the item template
+struct AuctionSearchFilter
+{
+    AuctionSearchFilter() : levelmin(0), levelmax(0), inventoryType(0xffffffff), itemClass(0xffffffff), itemSubClass(0xffffffff), quality(0xffffffff), locale(-1) {}
+
+    std::wstring name;                                      // already lower case, empty for any
+    uint32 levelmin;                                        // 0 for any
+    uint32 levelmax;                                        // 0 for no upper limit
+    uint32 inventoryType;
+    uint32 itemClass;
+    uint32 itemSubClass;
+    uint32 quality;                                         // minimal quality
+    int locale;                                             // db locale index used for name match
+};
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -110,6 +125,7 @@ class AuctionHouseObject
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            AddToSearchIndex(ah);
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -120,18 +136,41 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id)
         {
-            return AuctionsMap.erase(id) > 0;
+            AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+            if (itr == AuctionsMap.end())
+                return false;
+
+            RemoveFromSearchIndex(itr->second);
+            AuctionsMap.erase(itr);
+            return true;
         }
 
         void Update();
 
+        // active auctions with existing item that pass the filter, in auction id order
+        void SearchAuctions(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& result) const;
+
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListPendingSales(WorldPacket& data, Player* player, uint32& count);
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        // every index bucket is ordered by auction id like AuctionsMap itself
+        typedef std::map<uint32, AuctionEntryMap> AuctionIndex;
+        typedef std::vector<AuctionEntryMap const*> AuctionIndexBuckets;
+
+        void AddToSearchIndex(AuctionEntry* auction);
+        void RemoveFromSearchIndex(AuctionEntry* auction);
+        static size_t CollectBuckets(AuctionIndex const& index, uint32 lowKey, uint32 highKey, AuctionIndexBuckets& buckets);
+
         AuctionEntryMap AuctionsMap;
+
+        AuctionIndex m_indexByClass;                        // class << 16 | subclass
+        AuctionIndex m_indexByInventoryType;
+        AuctionIndex m_indexByQuality;
+        AuctionIndex m_indexByLevel;                        // required level
+        AuctionIndex m_indexByTemplate;                     // item entry, used for name search
 };
 
 class AuctionSorter
@@ -193,12 +232,19 @@ class AuctionHouseMgr
         void AddAItem(Item* it);
         bool RemoveAItem(uint32 id);
 
+        // lower case localized item name as used by auction name search, cached per locale
+        std::wstring const& GetItemSearchName(uint32 itemEntry, int locale);
+        void ClearItemSearchNames() { mItemSearchNames.clear(); }
+
         void Update();
 
     private:
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        typedef std::unordered_map<uint32, std::wstring> ItemSearchNameMap;
+        std::map<int, ItemSearchNameMap> mItemSearchNames;  // db locale index -> item entry -> name
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
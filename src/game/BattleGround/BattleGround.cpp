@@ -560,13 +560,14 @@ void BattleGround::SetTeamStartLoc(Team team, float x, float y, float z, float o
 */
 void BattleGround::SendPacketToAll(WorldPacket const& packet)
 {
+    PacketBroadcast broadcast(packet);
     for (BattleGroundPlayerMap::const_iterator itr = m_players.begin(); itr != m_players.end(); ++itr)
     {
         if (itr->second.offlineRemoveTime)
             continue;
 
         if (Player* plr = sObjectMgr.GetPlayer(itr->first))
-            plr->GetSession()->SendPacket(packet);
+            broadcast.SendTo(plr->GetSession());
         else
             sLog.outError("BattleGround:SendPacketToAll: %s not found!", itr->first.GetString().c_str());
     }
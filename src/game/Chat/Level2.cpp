@@ -19,6 +19,7 @@
 #include "BattleGround.h"
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/WorldSnapshot.h"
 #include "Server/DBCStores.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
@@ -2031,6 +2032,7 @@ bool ChatHandler::HandleNpcFlagCommand(char* args)
     pCreature->SetUInt32Value(UNIT_NPC_FLAGS, npcFlags);
 
     WorldDatabase.PExecuteLog("UPDATE creature_template SET NpcFlags = '%u' WHERE entry = '%u'", npcFlags, pCreature->GetEntry());
+    sWorldSnapshot.Invalidate();
 
     SendSysMessage(LANG_VALUE_SAVED_REJOIN);
 
@@ -2167,6 +2169,7 @@ bool ChatHandler::HandleNpcMoveCommand(char* args)
     }
 
     WorldDatabase.PExecuteLog("UPDATE creature SET position_x = '%f', position_y = '%f', position_z = '%f', orientation = '%f' WHERE guid = '%u'", x, y, z, o, lowguid);
+    sWorldSnapshot.Invalidate();
     PSendSysMessage(LANG_COMMAND_CREATUREMOVED);
     return true;
 }
@@ -2330,6 +2333,7 @@ bool ChatHandler::HandleNpcFactionIdCommand(char* args)
 
     // and DB
     WorldDatabase.PExecuteLog("UPDATE creature_template SET Faction = '%u', WHERE entry = '%u'", factionId, pCreature->GetEntry());
+    sWorldSnapshot.Invalidate();
 
     return true;
 }
@@ -2389,6 +2393,7 @@ bool ChatHandler::HandleNpcSpawnDistCommand(char* args)
     }
 
     WorldDatabase.PExecuteLog("UPDATE creature SET spawndist=%f, MovementType=%i WHERE guid=%u", option, mtype, pCreature->GetGUIDLow());
+    sWorldSnapshot.Invalidate();
     PSendSysMessage(LANG_COMMAND_SPAWNDIST, option);
     return true;
 }
@@ -2410,6 +2415,7 @@ bool ChatHandler::HandleNpcSpawnTimeCommand(char* args)
     uint32 u_guidlow = pCreature->GetGUIDLow();
 
     WorldDatabase.PExecuteLog("UPDATE creature SET spawntimesecsmin=%i, spawntimesecsmax=%i WHERE guid=%u", stime, stime, u_guidlow);
+    sWorldSnapshot.Invalidate();
     pCreature->SetRespawnDelay(stime);
     PSendSysMessage(LANG_COMMAND_SPAWNTIME, stime);
 
@@ -5380,6 +5386,7 @@ bool ChatHandler::HandleMmapLocCommand(char* /*args*/)
         PSendSysMessage("Mmap is not enabled.");
         return true;
     }
+    auto meshGuard = mmap->LockNavMesh(player->GetMapId(), player->GetInstanceId());
     const dtNavMesh* navmesh = mmap->GetNavMesh(player->GetMapId(), player->GetInstanceId());
     const dtNavMeshQuery* navmeshquery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(player->GetMapId(), player->GetInstanceId());
     if (!navmesh || !navmeshquery)
@@ -5433,6 +5440,7 @@ bool ChatHandler::HandleMmapLoadedTilesCommand(char* /*args*/)
     uint32 mapId = m_session->GetPlayer()->GetMapId();
     uint32 instanceId = m_session->GetPlayer()->GetInstanceId();
 
+    auto meshGuard = mmap->LockNavMesh(mapId, instanceId);
     const dtNavMesh* navmesh = mmap->GetNavMesh(mapId, instanceId);
     const dtNavMeshQuery* navmeshquery = mmap->GetNavMeshQuery(mapId, m_session->GetPlayer()->GetInstanceId());
     if (!navmesh || !navmeshquery)
@@ -5469,6 +5477,7 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
 
     PSendSysMessage(" %u maps loaded with %u tiles overall", mmap->getLoadedMapsCount(), mmap->getLoadedTilesCount());
 
+    auto meshGuard = mmap->LockNavMesh(m_session->GetPlayer()->GetMapId(), m_session->GetPlayer()->GetInstanceId());
     const dtNavMesh* navmesh = mmap->GetNavMesh(m_session->GetPlayer()->GetMapId(), m_session->GetPlayer()->GetInstanceId());
     if (!navmesh)
     {
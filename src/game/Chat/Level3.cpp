@@ -1035,6 +1035,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sAuctionMgr.ClearItemSearchNames();
     SendGlobalSysMessage("DB table `locales_item` reloaded.");
     return true;
 }
@@ -64,7 +64,7 @@ float ThreatCalcHelper::CalcThreat(Unit* hatedUnit, Unit* hatingUnit, float thre
 //============================================================
 
 HostileReference::HostileReference(Unit* unit, ThreatManager* threatManager, float threat) : 
-    m_hostileState(STATE_NORMAL), m_tauntState(STATE_NONE)
+    m_hostileState(STATE_NORMAL), m_tauntState(STATE_NONE), m_listIndex(0), m_pendingIndex(ThreatOrder<HostileReference>::NOT_PENDING)
 {
     iThreat = threat;
     iFadeoutThreadReduction = 0.f;
@@ -212,12 +212,12 @@ Unit* HostileReference::getSourceUnit() const
 
 void ThreatContainer::clearReferences()
 {
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (HostileReference* ref : iOrder.refs())
     {
-        (*i)->unlink();
-        delete (*i);
+        ref->unlink();
+        delete ref;
     }
-    iThreatList.clear();
+    iOrder.clear();
 }
 
 //============================================================
@@ -230,7 +230,7 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
 
     ObjectGuid guid = victim->GetObjectGuid();
 
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (ThreatList::const_iterator i = iOrder.refs().begin(); i != iOrder.refs().end(); ++i)
         if ((*i)->getUnitGuid() == guid)
             return (*i);
 
@@ -271,16 +271,16 @@ void ThreatContainer::modifyAllThreatPercent(int32 threatPercent)
 {
     if (threatPercent < -100)
     {
-        while (!iThreatList.empty())
+        while (!empty())
         {
-            HostileReference* ref = *iThreatList.begin();
+            HostileReference* ref = iOrder.refs().front();
             ref->removeReference();
             delete ref;
         }
     }
     else
     {
-        for (auto itr : iThreatList)
+        for (auto itr : iOrder.refs())
             itr->addThreatPercent(threatPercent);
     }
 }
@@ -289,9 +289,10 @@ void ThreatContainer::modifyAllThreatPercent(int32 threatPercent)
 
 void ThreatContainer::update(bool force, bool isPlayer)
 {
-    if ((iDirty || force || isPlayer) && iThreatList.size() > 1)
+    if (force || isPlayer)
     {
-        iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+        // order depends on unit state and has to be rebuilt every time
+        iOrder.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
         {
             Unit* owner = lhs->getSource()->getOwner();
             if (isPlayer)
@@ -323,7 +324,8 @@ void ThreatContainer::update(bool force, bool isPlayer)
             return lhs->getThreat() > rhs->getThreat(); // reverse sorting
         });
     }
-    iDirty = false;
+    else
+        iOrder.update();
 }
 
 //============================================================
@@ -339,12 +341,11 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
     if (suppressRanged && currentVictim)
         currentVictimInMelee = attacker->CanReachWithMeleeAttack(currentVictim->getTarget());
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
-    for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    ThreatList const& threatList = iOrder.refs();
+    for (size_t i = 0; i < threatList.size() && !found;)
     {
-        currentRef = (*iter);
+        currentRef = threatList[i];
+        ThreatSortKey const& key = iOrder.keys()[i];
 
         Unit* target = currentRef->getTarget();
         MANGOS_ASSERT(target); // if the ref has status online the target must be there!
@@ -357,14 +358,14 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
             {
                 if (suppressRanged && !currentVictimInMelee)
                 {
-                    ++iter;
+                    ++i;
                     continue;
                 }
                 found = true;
                 break;
             }
 
-            if (currentRef->GetTauntState() > currentVictim->GetTauntState()) // taunt overrides root skipping
+            if (key.tauntState > currentVictim->GetTauntState()) // taunt overrides root skipping
             {
                 found = true;
                 break;
@@ -380,7 +381,7 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
             {
                 if (!isInMelee) // if current ref is not in melee - skip it
                 {
-                    ++iter;
+                    ++i;
                     continue;
                 }
                 else if (!currentVictimInMelee)
@@ -390,22 +391,22 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
                 }
             }
 
-            if (currentRef->GetHostileState() > currentVictim->GetHostileState())
+            if (key.hostileState > currentVictim->GetHostileState())
             {
                 found = true;
                 break;
             }
 
             // list sorted and and we check current target, then this is best case
-            if (currentRef->getThreat() <= 1.1f * currentVictim->getThreat())
+            if (key.threat <= 1.1f * currentVictim->getThreat())
             {
                 currentRef = currentVictim;
                 found = true;
                 break;
             }
 
-            if (currentRef->getThreat() > 1.3f * currentVictim->getThreat() ||
-                (currentRef->getThreat() > 1.1f * currentVictim->getThreat() && isInMelee))
+            if (key.threat > 1.3f * currentVictim->getThreat() ||
+                (key.threat > 1.1f * currentVictim->getThreat() && isInMelee))
             {
                 // implement 110% threat rule for targets in melee range
                 found = true;                           // and 130% rule for targets in ranged distances
@@ -417,7 +418,7 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
             found = true;
             break;
         }
-        ++iter;
+        ++i;
     }
     if (!found)
         currentRef = nullptr;
@@ -661,9 +662,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
     switch (threatRefStatusChangeEvent.getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent.getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent.getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            if (hostileReference->isOnline())
+                iThreatContainer.threatChanged(hostileReference); // the order in the threat list might have changed
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
@@ -682,9 +682,10 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
             {
                 if (getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
+                // removed first, the reference only knows its index in one container
+                iThreatOfflineContainer.remove(hostileReference);
                 iThreatContainer.addReference(hostileReference);
                 iUpdateNeed = true;
-                iThreatOfflineContainer.remove(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
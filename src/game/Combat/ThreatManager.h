@@ -25,7 +25,8 @@
 #include "Entities/UnitEvents.h"
 #include "Util/Timer.h"
 #include "Entities/ObjectGuid.h"
-#include <list>
+#include "Combat/ThreatOrder.h"
+#include <vector>
 
 //==============================================================
 
@@ -44,20 +45,6 @@ class ThreatCalcHelper
         static float CalcThreat(Unit* hatedUnit, Unit* hatingUnit, float threat, bool crit, SpellSchoolMask schoolMask, SpellEntry const* threatSpell, bool assist);
 };
 
-enum HostileState : uint32
-{
-    STATE_SUPPRESSED,
-    STATE_NORMAL,
-};
-
-enum TauntState : uint32
-{
-    STATE_DETAUNTED,
-    STATE_NONE,
-    STATE_TAUNTED,
-    STATE_FIXATED = UINT32_MAX,
-};
-
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatManager>
 {
@@ -134,6 +121,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
 
         Unit* getSourceUnit() const;
     private:
+        friend class ThreatOrder<HostileReference>;
+
         float iThreat;
         HostileState m_hostileState;
         bool m_suppresabilityToggle;
@@ -142,17 +131,21 @@ class HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool m_online;
         bool iAccessible;
+        uint32 m_listIndex;                                 // position in the ThreatOrder holding the reference
+        uint32 m_pendingIndex;                              // position in its queue of threat changes, if queued
 };
 
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+typedef std::vector<HostileReference*> ThreatList;
 
+// Ordered by ThreatOrder, see there. Loops which may add or remove references (casting, entering combat,
+// removing references) have to iterate a copy of the list.
 class ThreatContainer
 {
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() {}
         ~ThreatContainer() { clearReferences(); }
 
         HostileReference* addThreat(Unit* victim, float threat);
@@ -162,29 +155,29 @@ class ThreatContainer
 
         HostileReference* selectNextVictim(Unit* attacker, HostileReference* currentVictim);
 
-        void setDirty(bool dirty) { iDirty = dirty; }
+        void setDirty(bool dirty) { iOrder.setDirty(dirty); }
 
-        bool isDirty() const { return iDirty; }
+        bool isDirty() const { return iOrder.isDirty(); }
 
-        bool empty() const { return iThreatList.empty(); }
+        bool empty() const { return iOrder.refs().empty(); }
 
-        HostileReference* getMostHated() { return iThreatList.empty() ? nullptr : iThreatList.front(); }
+        HostileReference* getMostHated() { return empty() ? nullptr : iOrder.refs().front(); }
 
         HostileReference* getReferenceByTarget(Unit* victim);
 
-        ThreatList const& getThreatList() const { return iThreatList; }
+        ThreatList const& getThreatList() const { return iOrder.refs(); }
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* ref) { iThreatList.remove(ref); }
-        void addReference(HostileReference* hostileReference) { iThreatList.push_back(hostileReference); }
+        void remove(HostileReference* ref) { iOrder.remove(ref); }
+        void addReference(HostileReference* hostileReference) { iOrder.add(hostileReference); }
         void clearReferences();
+        // Queue a reference whose threat has changed for repositioning
+        void threatChanged(HostileReference* hostileReference) { iOrder.changed(hostileReference); }
         // Sort the list if necessary
         void update(bool force, bool isPlayer);
 
-        ThreatList iThreatList;
-    private:
-        bool iDirty;
+        ThreatOrder<HostileReference> iOrder;
 };
 
 //=================================================
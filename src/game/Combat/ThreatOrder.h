@@ -0,0 +1,253 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _THREATORDER
+#define _THREATORDER
+
+#include "Platform/Define.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+enum HostileState : uint32
+{
+    STATE_SUPPRESSED,
+    STATE_NORMAL,
+};
+
+enum TauntState : uint32
+{
+    STATE_DETAUNTED,
+    STATE_NONE,
+    STATE_TAUNTED,
+    STATE_FIXATED = UINT32_MAX,
+};
+
+// The values a threat list is ordered by, most hated first
+struct ThreatSortKey
+{
+    ThreatSortKey() : tauntState(STATE_NONE), hostileState(STATE_NORMAL), threat(0.f) {}
+    template<class Ref>
+    explicit ThreatSortKey(Ref const* ref) : tauntState(ref->GetTauntState()), hostileState(ref->GetHostileState()), threat(ref->getThreat()) {}
+
+    // reverse order, most hated first
+    bool operator<(ThreatSortKey const& other) const
+    {
+        if (tauntState != other.tauntState)
+            return tauntState > other.tauntState;
+        if (hostileState != other.hostileState)
+            return hostileState > other.hostileState;
+        return threat > other.threat;
+    }
+    bool operator==(ThreatSortKey const& other) const { return tauntState == other.tauntState && hostileState == other.hostileState && threat == other.threat; }
+
+    TauntState tauntState;
+    HostileState hostileState;
+    float threat;
+};
+
+// Threat list kept as flat arrays: the references and, at the same index, a copy of the values they are
+// ordered by, so that ordering and victim selection do not have to visit every reference.
+// Threat changes only queue the reference, it is moved to its new place on the next update() so that
+// iterating the list while modifying threat stays valid. Adding or removing references does invalidate
+// iterators, loops which may do so have to iterate a copy.
+// Every reference knows its index in the list and in the queue (m_listIndex, m_pendingIndex), so finding
+// it takes constant time.
+template<class Ref>
+class ThreatOrder
+{
+    public:
+        static constexpr uint32 NOT_PENDING = UINT32_MAX;
+
+        ThreatOrder() : m_dirty(false), m_orderedByKey(true) {}
+
+        std::vector<Ref*> const& refs() const { return m_refs; }
+        std::vector<ThreatSortKey> const& keys() const { return m_keys; }
+
+        bool contains(Ref const* ref) const { return ref->m_listIndex < m_refs.size() && m_refs[ref->m_listIndex] == ref; }
+
+        void setDirty(bool dirty) { m_dirty = dirty; }
+        bool isDirty() const { return m_dirty; }
+
+        void add(Ref* ref)
+        {
+            ThreatSortKey key(ref);
+            size_t index = m_refs.size();
+            if (!m_dirty && m_orderedByKey)
+                index = std::upper_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin();
+
+            m_refs.insert(m_refs.begin() + index, ref);
+            m_keys.insert(m_keys.begin() + index, key);
+            updateIndices(index, m_refs.size());
+        }
+
+        void remove(Ref* ref)
+        {
+            if (!contains(ref))
+                return;
+
+            size_t index = ref->m_listIndex;
+            m_keys.erase(m_keys.begin() + index);
+            m_refs.erase(m_refs.begin() + index);
+            updateIndices(index, m_refs.size());
+
+            if (ref->m_pendingIndex != NOT_PENDING)
+                dequeue(ref);
+        }
+
+        void clear()
+        {
+            m_refs.clear();
+            m_keys.clear();
+            m_pending.clear();
+        }
+
+        // Queue a reference whose threat or state has changed for repositioning
+        void changed(Ref* ref)
+        {
+            if (m_dirty || ref->m_pendingIndex != NOT_PENDING || !contains(ref))
+                return;
+
+            // with many changes at once (e.g. threat wipe) one sort is cheaper than moving each reference
+            if (m_pending.size() >= m_refs.size() / 2 + 1)
+            {
+                m_dirty = true;
+                clearPending();
+                return;
+            }
+
+            ref->m_pendingIndex = uint32(m_pending.size());
+            m_pending.push_back(ref);
+        }
+
+        // Bring the list back into key order, moving only the queued references if nothing else changed
+        void update()
+        {
+            if (m_dirty || !m_orderedByKey)
+                sortByKey();
+            else
+            {
+                for (Ref* ref : m_pending)
+                    reposition(ref->m_listIndex);
+            }
+
+            clearPending();
+            m_dirty = false;
+        }
+
+        // Order by criteria beyond the key (e.g. unit state), the next update() sorts by key again
+        template<class Compare>
+        void sort(Compare&& compare)
+        {
+            if (m_refs.size() > 1)
+                std::stable_sort(m_refs.begin(), m_refs.end(), compare);
+
+            for (size_t i = 0; i < m_refs.size(); ++i)
+            {
+                m_keys[i] = ThreatSortKey(m_refs[i]);
+                m_refs[i]->m_listIndex = uint32(i);
+            }
+            m_orderedByKey = false;
+
+            clearPending();
+            m_dirty = false;
+        }
+
+    private:
+        void updateIndices(size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+                m_refs[i]->m_listIndex = uint32(i);
+        }
+
+        void dequeue(Ref* ref)
+        {
+            // order of the queue does not matter, fill the gap with the last one
+            Ref* last = m_pending.back();
+            m_pending[ref->m_pendingIndex] = last;
+            last->m_pendingIndex = ref->m_pendingIndex;
+            m_pending.pop_back();
+            ref->m_pendingIndex = NOT_PENDING;
+        }
+
+        void clearPending()
+        {
+            for (Ref* ref : m_pending)
+                ref->m_pendingIndex = NOT_PENDING;
+            m_pending.clear();
+        }
+
+        void sortByKey()
+        {
+            m_sortBuffer.clear();
+            for (Ref* ref : m_refs)
+                m_sortBuffer.emplace_back(ThreatSortKey(ref), ref);
+
+            std::stable_sort(m_sortBuffer.begin(), m_sortBuffer.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+
+            for (size_t i = 0; i < m_sortBuffer.size(); ++i)
+            {
+                m_keys[i] = m_sortBuffer[i].first;
+                m_refs[i] = m_sortBuffer[i].second;
+                m_refs[i]->m_listIndex = uint32(i);
+            }
+            m_orderedByKey = true;
+        }
+
+        // Refresh the key at index and move the entry to its place, the rest of the list is ordered
+        void reposition(size_t index)
+        {
+            ThreatSortKey key(m_refs[index]);
+            if (key == m_keys[index])
+                return;
+
+            m_keys[index] = key;
+
+            auto keyItr = m_keys.begin() + index;
+            auto refItr = m_refs.begin() + index;
+
+            if (index > 0 && key < m_keys[index - 1])
+            {
+                // moves up, behind the entries with an equal key
+                auto destination = std::upper_bound(m_keys.begin(), keyItr, key);
+                size_t offset = destination - m_keys.begin();
+                std::rotate(destination, keyItr, keyItr + 1);
+                std::rotate(m_refs.begin() + offset, refItr, refItr + 1);
+                updateIndices(offset, index + 1);
+            }
+            else if (index + 1 < m_keys.size() && m_keys[index + 1] < key)
+            {
+                // moves down, in front of the entries with an equal key
+                auto destination = std::lower_bound(keyItr + 1, m_keys.end(), key);
+                size_t offset = destination - m_keys.begin();
+                std::rotate(keyItr, keyItr + 1, destination);
+                std::rotate(refItr, refItr + 1, m_refs.begin() + offset);
+                updateIndices(index, offset);
+            }
+        }
+
+        std::vector<Ref*> m_refs;
+        std::vector<ThreatSortKey> m_keys;                  // parallel to m_refs
+        std::vector<Ref*> m_pending;
+        std::vector<std::pair<ThreatSortKey, Ref*>> m_sortBuffer;
+        bool m_dirty;
+        bool m_orderedByKey;                                // false after sort() ordered by other criteria
+};
+
+#endif
@@ -111,7 +111,7 @@ void PlayerbotHolder::AddPlayerBot(uint32 playerGuid, uint32 masterAccount)
         return;
     }
 
-    CharacterDatabase.DelayQueryHolder(this, &PlayerbotHolder::HandlePlayerBotLoginCallback, holder);
+    CharacterDatabase.DelayQueryHolder(playerGuid, this, &PlayerbotHolder::HandlePlayerBotLoginCallback, holder);
 }
 
 void PlayerbotHolder::HandlePlayerBotLoginCallback(QueryResult* dummy, SqlQueryHolder* holder)
@@ -811,7 +811,8 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recv_data)
         return;
     }
 
-    CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerLoginCallback, holder);
+    // keyed like Player::SaveToDB, so that a relog reads what the logout save wrote
+    CharacterDatabase.DelayQueryHolder(playerGuid.GetCounter(), &chrHandler, &CharacterHandler::HandlePlayerLoginCallback, holder);
 }
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
@@ -833,7 +834,7 @@ void PlayerbotMgr::LoginPlayerBot(ObjectGuid playerGuid)
         delete holder;                                      // delete all unprocessed queries
         return;
     }
-    CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerBotLoginCallback, holder);
+    CharacterDatabase.DelayQueryHolder(playerGuid.GetCounter(), &chrHandler, &CharacterHandler::HandlePlayerBotLoginCallback, holder);
 }
 #endif
 
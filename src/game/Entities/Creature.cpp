@@ -18,6 +18,7 @@
 
 #include "Entities/Creature.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/WorldSnapshot.h"
 #include "Server/WorldPacket.h"
 #include "World/World.h"
 #include "Globals/ObjectMgr.h"
@@ -1370,6 +1371,8 @@ void Creature::SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask)
     WorldDatabase.PExecuteLog("%s", ss.str().c_str());
 
     WorldDatabase.CommitTransaction();
+
+    sWorldSnapshot.Invalidate();
 }
 
 void Creature::SelectLevel(uint32 forcedLevel /*= USE_DEFAULT_DATABASE_LEVEL*/)
@@ -2064,6 +2067,8 @@ void Creature::DeleteFromDB(uint32 lowguid, CreatureData const* data)
     WorldDatabase.PExecuteLog("DELETE FROM creature_battleground WHERE guid=%u", lowguid);
     WorldDatabase.PExecuteLog("DELETE FROM creature_linking WHERE guid=%u OR master_guid=%u", lowguid, lowguid);
     WorldDatabase.CommitTransaction();
+
+    sWorldSnapshot.Invalidate();
 }
 
 void Creature::SetDeathState(DeathState s)
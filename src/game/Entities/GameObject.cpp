@@ -19,6 +19,7 @@
 #include "Entities/GameObject.h"
 #include "Quests/QuestDef.h"
 #include "Globals/ObjectMgr.h"
+#include "Database/WorldSnapshot.h"
 #include "Pools/PoolManager.h"
 #include "Spells/SpellMgr.h"
 #include "Spells/Spell.h"
@@ -638,7 +639,7 @@ void GameObject::Update(const uint32 diff)
             switch (GetGoType())
             {
                 case GAMEOBJECT_TYPE_TRAP:
-                    if (m_events.GetEvents().size() > 0)
+                    if (!m_events.IsEmpty())
                     {
                         preventDespawn = true;
                         break;
@@ -933,6 +934,8 @@ void GameObject::SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask) const
     WorldDatabase.PExecuteLog("DELETE FROM gameobject WHERE guid = '%u'", GetGUIDLow());
     WorldDatabase.PExecuteLog("%s", ss.str().c_str());
     WorldDatabase.CommitTransaction();
+
+    sWorldSnapshot.Invalidate();
 }
 
 bool GameObject::LoadFromDB(uint32 dbGuid, Map* map, uint32 newGuid, uint32 forcedEntry, GenericTransport* transport)
@@ -1078,6 +1081,8 @@ void GameObject::DeleteFromDB() const
     WorldDatabase.PExecuteLog("DELETE FROM gameobject WHERE guid = '%u'", GetDbGuid());
     WorldDatabase.PExecuteLog("DELETE FROM game_event_gameobject WHERE guid = '%u'", GetDbGuid());
     WorldDatabase.PExecuteLog("DELETE FROM gameobject_battleground WHERE guid = '%u'", GetDbGuid());
+
+    sWorldSnapshot.Invalidate();
 }
 
 void GameObject::SetOwnerGuid(ObjectGuid guid)
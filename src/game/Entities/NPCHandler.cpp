@@ -728,7 +728,7 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
         else
         {
             // change pet slot directly in database
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(_player->GetGUIDLow());
             static SqlStatementID ChangePetSlot_ID;
             SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
             ChangePetSlot.PExecute(free_slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
@@ -837,7 +837,7 @@ void WorldSession::HandleUnstablePet(WorldPacket& recv_data)
         else
         {
             // change pet slot directly in database
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(_player->GetGUIDLow());
             static SqlStatementID ChangePetSlot_ID;
             SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
             ChangePetSlot.PExecute(slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
@@ -983,7 +983,7 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recv_data)
     else
     {
         // change pet slot directly in memory
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(_player->GetGUIDLow());
         static SqlStatementID ChangePetSlot_ID;
         SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
         ChangePetSlot.PExecute(slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
@@ -219,14 +219,93 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData& data, Player* target) c
     data.AddUpdateBlock(buf);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, ValuesUpdateCache* cache) const
 {
+    // self view carries private fields and is only ever built once
+    if (!cache || cache->viewerDependent || target == this)
+    {
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(updateMask, target);
+        if (updateMask.HasData())
+            BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+        return;
+    }
+
+    uint32 updateClass = GetValuesUpdateClassForTarget(target);
+    for (auto const& block : cache->blocks)
+    {
+        if (block.first == updateClass)
+        {
+            if (!block.second.empty())
+                data.AddUpdateBlock(block.second);
+            return;
+        }
+    }
+
+    cache->blocks.emplace_back(updateClass, ByteBuffer(0));
+    ByteBuffer& buf = cache->blocks.back().second;
+
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
     _SetUpdateBits(updateMask, target);
-    if (updateMask.HasData())
-        BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+    if (!updateMask.HasData())
+        return;
+
+    buf.reserve(500);
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetPackGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    data.AddUpdateBlock(buf);
+}
+
+bool Object::HasViewerDependentChangedValues() const
+{
+    // mirrors the per target special cases of BuildValuesUpdate
+    if (isType(TYPEMASK_UNIT))
+    {
+        if (static_cast<Unit const*>(this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            return true;
+
+        if (m_changedValues[UNIT_NPC_FLAGS] || m_changedValues[UNIT_FIELD_AURASTATE] || m_changedValues[UNIT_DYNAMIC_FLAGS])
+            return true;
+
+        return GetTypeId() == TYPEID_PLAYER && m_changedValues[UNIT_FIELD_FACTIONTEMPLATE];
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return !static_cast<GameObject const*>(this)->IsDynTransport();
+
+    if (isType(TYPEMASK_CORPSE))
+        return m_changedValues[CORPSE_FIELD_BYTES_1];
+
+    return false;
+}
+
+uint32 Object::GetValuesUpdateClassForTarget(Player const* target) const
+{
+    // public, group, owner and special info visibility
+    uint16 const* flags = nullptr;
+    uint32 updateClass = GetUpdateFieldFlagsForTarget(target, flags);
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        Unit const* unit = static_cast<Unit const*>(this);
+
+        // Fog of War health
+        if (m_changedValues[UNIT_FIELD_HEALTH] || m_changedValues[UNIT_FIELD_MAXHEALTH])
+            if (unit->IsFogOfWarVisibleHealth(target) || target->CanSeeSpecialInfoOf(unit))
+                updateClass |= 0x10000;
+
+        // gamemasters see unselectable units as selectable
+        if (m_changedValues[UNIT_FIELD_FLAGS] && target->IsGameMaster())
+            updateClass |= 0x20000;
+    }
+
+    return updateClass;
 }
 
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
@@ -1262,7 +1341,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1273,7 +1352,7 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(iter->second, iter->first, cache);
 }
 
 void Object::BuildCreateDataForPlayer(Player* pl, UpdateDataMapType& update_players, bool auras) const
@@ -2180,6 +2259,22 @@ void WorldObject::SendMessageToSetExcept(WorldPacket const& data, Player const*
     }
 }
 
+void WorldObject::SendMovementMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const
+{
+    if (!sWorld.getConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_DELAY))
+    {
+        SendMessageToSetExcept(data, skipped_receiver);
+        return;
+    }
+
+    // receivers get it with the next flush of their map, see Map::SendMovementUpdates
+    if (IsInWorld())
+    {
+        MaNGOS::MovementMessageDeliverer notifier(this, data, skipped_receiver);
+        Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
+    }
+}
+
 void WorldObject::SendMessageToAllWhoSeeMe(WorldPacket const& data, bool /*self*/) const
 {
     if (IsInWorld())
@@ -2812,11 +2907,15 @@ void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
     if (IsPlayer())
         BuildUpdateDataForPlayer((Player*)this, update_players);
 
+    // viewers in the same visibility class receive the same values block
+    ValuesUpdateCache cache;
+    cache.viewerDependent = HasViewerDependentChangedValues();
+
     for (auto& iter : m_clientGUIDsIAmAt)
     {
         if (Player* player = GetMap()->GetPlayer(iter))
             if (player != this && player->HasAtClient(this))
-                BuildUpdateDataForPlayer(player, update_players);
+                BuildUpdateDataForPlayer(player, update_players, &cache);
     }
 
     ClearUpdateMask(false);
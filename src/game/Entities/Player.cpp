@@ -585,6 +585,11 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     m_DailyQuestChanged = false;
     m_WeeklyQuestChanged = false;
 
+    m_characterRowSaved = false;
+    m_savedAurasValid = false;
+    m_savedCooldownsValid = false;
+    m_enteredInstancesChanged = true;
+
     m_lastLiquid = nullptr;
 
     m_drunkTimer = 0;
@@ -4243,13 +4248,12 @@ void Player::_LoadSpellCooldowns(std::unique_ptr<QueryResult> queryResult)
 
 void Player::_SaveSpellCooldowns()
 {
+    static SqlStatementID deleteSpellCooldowns;
     static SqlStatementID deleteSpellCooldown;
-
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
     static SqlStatementID insertSpellCooldown;
+    static SqlStatementID updateSpellCooldown;
+
+    std::map<uint32, SavedCooldownRow> cooldowns;
 
     TimePoint now = GetMap()->GetCurrentClockTime();
     for (auto& cdItr : m_cooldownMap)
@@ -4266,19 +4270,72 @@ void Player::_SaveSpellCooldowns()
             if (sTime <= now && cTime <= now)
                 continue;
 
-            uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
-            uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
+            SavedCooldownRow row;
+            row.spellExpireTime = uint64(Clock::to_time_t(sTime));
+            row.category = cdData->GetCategory();
+            row.catExpireTime = uint64(Clock::to_time_t(cTime));
+            row.itemId = cdData->GetItemId();
+            cooldowns.emplace(cdData->GetSpellId(), row);
+        }
+    }
+
+    auto insertRow = [this](uint32 spellId, SavedCooldownRow const& row)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(spellId);
+        stmt.addUInt64(row.spellExpireTime);
+        stmt.addUInt32(row.category);
+        stmt.addUInt64(row.catExpireTime);
+        stmt.addUInt32(row.itemId);
+        stmt.Execute();
+    };
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
+    if (!m_savedCooldownsValid)
+    {
+        // delete all old cooldown
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldowns, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+
+        for (auto const& cooldown : cooldowns)
+            insertRow(cooldown.first, cooldown.second);
+    }
+    else
+    {
+        for (auto const& saved : m_savedCooldowns)
+        {
+            if (cooldowns.find(saved.first) != cooldowns.end())
+                continue;
+
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ? AND SpellId = ?");
+            stmt.PExecute(GetGUIDLow(), saved.first);
+        }
+
+        for (auto const& cooldown : cooldowns)
+        {
+            auto savedItr = m_savedCooldowns.find(cooldown.first);
+            if (savedItr == m_savedCooldowns.end())
+            {
+                insertRow(cooldown.first, cooldown.second);
+                continue;
+            }
+
+            if (savedItr->second == cooldown.second)
+                continue;
+
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updateSpellCooldown, "UPDATE character_spell_cooldown SET SpellExpireTime = ?, Category = ?, CategoryExpireTime = ?, ItemId = ? WHERE guid = ? AND SpellId = ?");
+            stmt.addUInt64(cooldown.second.spellExpireTime);
+            stmt.addUInt32(cooldown.second.category);
+            stmt.addUInt64(cooldown.second.catExpireTime);
+            stmt.addUInt32(cooldown.second.itemId);
             stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt32(cdData->GetSpellId());
-            stmt.addUInt64(spellExpireTime);
-            stmt.addUInt32(cdData->GetCategory());
-            stmt.addUInt64(catExpireTime);
-            stmt.addUInt32(cdData->GetItemId());
+            stmt.addUInt32(cooldown.first);
             stmt.Execute();
         }
     }
+
+    m_savedCooldowns = std::move(cooldowns);
+    m_savedCooldownsValid = true;
 }
 
 uint32 Player::resetTalentsCost() const
@@ -4808,7 +4865,8 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             auto  resultFriend = CharacterDatabase.PQuery("SELECT DISTINCT guid FROM character_social WHERE friend = '%u'", lowguid);
 
             // NOW we can finally clear other DB data related to character
-            CharacterDatabase.BeginTransaction();
+            // ordered with pending saves of the same character
+            CharacterDatabase.BeginTransaction(lowguid);
             if (resultPets)
             {
                 do
@@ -16637,6 +16695,8 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
         return false;
     }
 
+    m_characterRowSaved = true;
+
     m_name = fields[2].GetCppString();
 
     // check name limitations
@@ -18517,7 +18577,8 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    // saves of different characters may run in parallel on separate async connections
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
 #ifdef BUILD_ELUNA
     // Hack to check that this is not on create save
@@ -18528,11 +18589,19 @@ void Player::SaveToDB()
 
     static SqlStatementID delChar ;
     static SqlStatementID insChar ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
+    static SqlStatementID updChar ;
+
+    // the row only has to be created once, later saves update it in place
+    SqlStatement uberInsert = m_characterRowSaved ? CharacterDatabase.CreateStatement(updChar, "UPDATE characters SET account = ?, name = ?, race = ?, class = ?, gender = ?, level = ?, xp = ?, money = ?, playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+                              "map = ?, dungeon_difficulty = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, "
+                              "taximask = ?, online = ?, cinematic = ?, "
+                              "totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, resettalents_cost = ?, resettalents_time = ?, "
+                              "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, extra_flags = ?, stable_slots = ?, at_login = ?, zone = ?, "
+                              "death_expire_time = ?, taxi_path = ?, arenaPoints = ?, totalHonorPoints = ?, todayHonorPoints = ?, yesterdayHonorPoints = ?, totalKills = ?, "
+                              "todayKills = ?, yesterdayKills = ?, chosenTitle = ?, knownCurrencies = ?, watchedFaction = ?, drunk = ?, health = ?, power1 = ?, power2 = ?, power3 = ?, "
+                              "power4 = ?, power5 = ?, power6 = ?, power7 = ?, specCount = ?, activeSpec = ?, exploredZones = ?, equipmentCache = ?, ammoId = ?, knownTitles = ?, actionBars = ?, grantableLevels = ?, fishingSteps = ? "
+                              "WHERE guid = ?")
+                              : CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
                               "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
                               "taximask, online, cinematic, "
                               "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
@@ -18549,7 +18618,14 @@ void Player::SaveToDB()
                               "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
                               "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) ");
 
-    uberInsert.addUInt32(GetGUIDLow());
+    if (!m_characterRowSaved)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+
+        uberInsert.addUInt32(GetGUIDLow());
+    }
+
     uberInsert.addUInt32(GetSession()->GetAccountId());
     uberInsert.addString(m_name);
     uberInsert.addUInt8(getRace());
@@ -18687,7 +18763,11 @@ void Player::SaveToDB()
 
     uberInsert.addUInt8(m_fishingSteps);
 
+    if (m_characterRowSaved)
+        uberInsert.addUInt32(GetGUIDLow());
+
     uberInsert.Execute();
+    m_characterRowSaved = true;
 
     if (m_mailsUpdated)                                     // save mails only when needed
         _SaveMail();
@@ -18797,20 +18877,13 @@ void Player::_SaveActions()
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
+    static SqlStatementID deleteAura ;
     static SqlStatementID insertAuras ;
+    static SqlStatementID updateAura ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    std::map<SavedAuraKey, SavedAuraRow> auras;
 
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
-
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
     for (const auto& auraHolder : auraHolders)
     {
         SpellAuraHolder* holder = auraHolder.second;
@@ -18818,14 +18891,13 @@ void Player::_SaveAuras()
         // save singleTarget auras if self cast.
         if (holder->IsSaveToDbHolder())
         {
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
-            uint32 effIndexMask = 0;
+            SavedAuraRow row;
+            row.effIndexMask = 0;
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                damage[i] = 0;
-                periodicTime[i] = 0;
+                row.damage[i] = 0;
+                row.periodicTime[i] = 0;
 
                 if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
                 {
@@ -18833,34 +18905,112 @@ void Player::_SaveAuras()
                     if (!aur->IsSaveToDbAura())
                         continue;
 
-                    damage[i] = aur->GetModifier()->m_amount;
-                    periodicTime[i] = aur->GetModifier()->periodictime;
-                    effIndexMask |= (1 << i);
+                    row.damage[i] = aur->GetModifier()->m_amount;
+                    row.periodicTime[i] = aur->GetModifier()->periodictime;
+                    row.effIndexMask |= (1 << i);
                 }
             }
 
-            if (!effIndexMask)
+            if (!row.effIndexMask)
+                continue;
+
+            row.stackAmount = holder->GetStackAmount();
+            row.charges = holder->GetAuraCharges();
+            row.maxDuration = holder->GetAuraMaxDuration();
+            row.duration = holder->GetAuraDuration();
+
+            auras.emplace(SavedAuraKey(holder->GetCasterGuid().GetRawValue(), holder->GetCastItemGuid().GetCounter(), holder->GetId()), row);
+        }
+    }
+
+    auto insertRow = [this](SavedAuraKey const& key, SavedAuraRow const& row)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+                "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt64(std::get<0>(key));
+        stmt.addUInt32(std::get<1>(key));
+        stmt.addUInt32(std::get<2>(key));
+        stmt.addUInt32(row.stackAmount);
+        stmt.addUInt8(row.charges);
+
+        for (int32 i : row.damage)
+            stmt.addInt32(i);
+
+        for (uint32 i : row.periodicTime)
+            stmt.addUInt32(i);
+
+        stmt.addInt32(row.maxDuration);
+        stmt.addInt32(row.duration);
+        stmt.addUInt32(row.effIndexMask);
+        stmt.Execute();
+    };
+
+    if (!m_savedAurasValid)
+    {
+        // first save after login, DB content is unknown
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+
+        for (auto const& aura : auras)
+            insertRow(aura.first, aura.second);
+    }
+    else
+    {
+        for (auto const& saved : m_savedAuras)
+        {
+            if (auras.find(saved.first) != auras.end())
                 continue;
 
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAura, "DELETE FROM character_aura WHERE guid = ? AND caster_guid = ? AND item_guid = ? AND spell = ?");
             stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            stmt.addUInt64(std::get<0>(saved.first));
+            stmt.addUInt32(std::get<1>(saved.first));
+            stmt.addUInt32(std::get<2>(saved.first));
+            stmt.Execute();
+        }
+
+        for (auto const& aura : auras)
+        {
+            auto savedItr = m_savedAuras.find(aura.first);
+            if (savedItr == m_savedAuras.end())
+            {
+                insertRow(aura.first, aura.second);
+                continue;
+            }
+
+            if (savedItr->second == aura.second)
+                continue;
+
+            SavedAuraRow const& row = aura.second;
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updateAura, "UPDATE character_aura SET stackcount = ?, remaincharges = ?, "
+                    "basepoints0 = ?, basepoints1 = ?, basepoints2 = ?, periodictime0 = ?, periodictime1 = ?, periodictime2 = ?, maxduration = ?, remaintime = ?, effIndexMask = ? "
+                    "WHERE guid = ? AND caster_guid = ? AND item_guid = ? AND spell = ?");
+
+            stmt.addUInt32(row.stackAmount);
+            stmt.addUInt8(row.charges);
 
-            for (int i : damage)
+            for (int32 i : row.damage)
                 stmt.addInt32(i);
 
-            for (unsigned int i : periodicTime)
+            for (uint32 i : row.periodicTime)
                 stmt.addUInt32(i);
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
+            stmt.addInt32(row.maxDuration);
+            stmt.addInt32(row.duration);
+            stmt.addUInt32(row.effIndexMask);
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(std::get<0>(aura.first));
+            stmt.addUInt32(std::get<1>(aura.first));
+            stmt.addUInt32(std::get<2>(aura.first));
             stmt.Execute();
         }
     }
+
+    m_savedAuras = std::move(auras);
+    m_savedAurasValid = true;
 }
 
 void Player::_SaveGlyphs()
@@ -25910,7 +26060,10 @@ bool Player::CanEnterNewInstance(uint32 instanceId)
 void Player::AddNewInstanceId(uint32 instanceId)
 {
     if (m_enteredInstances.find(instanceId) == m_enteredInstances.end())
+    {
         m_enteredInstances.emplace(instanceId, std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now() + std::chrono::hours(1)));
+        m_enteredInstancesChanged = true;
+    }
 }
 
 void Player::_LoadCreatedInstanceTimers()
@@ -25927,7 +26080,8 @@ void Player::_LoadCreatedInstanceTimers()
 
             if (expireTime > Clock::now())
                 m_enteredInstances.emplace(instanceId, expireTime);
-
+            else
+                m_enteredInstancesChanged = true;           // clean up expired rows at next save
         }
         while (queryResult->NextRow());
     }
@@ -25935,6 +26089,11 @@ void Player::_LoadCreatedInstanceTimers()
 
 void Player::_SaveNewInstanceIdTimer()
 {
+    if (!m_enteredInstancesChanged)
+        return;
+
+    m_enteredInstancesChanged = false;
+
     CharacterDatabase.PExecute("DELETE FROM account_instances_entered WHERE AccountId = '%u'", m_session->GetAccountId());
 
     if (m_enteredInstances.empty())
@@ -25959,7 +26118,10 @@ void Player::UpdateNewInstanceIdTimers(TimePoint const& now)
     for (auto iter = m_enteredInstances.begin(); iter != m_enteredInstances.end();)
     {
         if ((*iter).second < now)
+        {
             iter = m_enteredInstances.erase(iter);
+            m_enteredInstancesChanged = true;
+        }
         else
             ++iter;
     }
@@ -45,6 +45,8 @@
 #include "BattleGround/BattleGroundDefines.h"
 
 #include <functional>
+#include <map>
+#include <tuple>
 #include <vector>
 
 struct Mail;
@@ -2860,6 +2862,39 @@ class Player : public Unit
         bool   m_WeeklyQuestChanged;
         bool   m_MonthlyQuestChanged;
 
+        // characters row exists in DB, saves update it in place
+        bool   m_characterRowSaved;
+
+        // aura and cooldown rows as last written to DB, later saves only write the difference
+        // invalid until the first full save after login
+        struct SavedAuraRow
+        {
+            uint32 stackAmount;
+            uint8  charges;
+            int32  damage[MAX_EFFECT_INDEX];
+            uint32 periodicTime[MAX_EFFECT_INDEX];
+            int32  maxDuration;
+            int32  duration;
+            uint32 effIndexMask;
+
+            bool operator==(SavedAuraRow const&) const = default;
+        };
+        typedef std::tuple<uint64, uint32, uint32> SavedAuraKey;    // caster guid, item guid, spell
+        std::map<SavedAuraKey, SavedAuraRow> m_savedAuras;
+        bool   m_savedAurasValid;
+
+        struct SavedCooldownRow
+        {
+            uint64 spellExpireTime;
+            uint32 category;
+            uint64 catExpireTime;
+            uint32 itemId;
+
+            bool operator==(SavedCooldownRow const&) const = default;
+        };
+        std::map<uint32, SavedCooldownRow> m_savedCooldowns;
+        bool   m_savedCooldownsValid;
+
         uint32 m_drunkTimer;
 
         uint32 m_zoneUpdateId;
@@ -3030,6 +3065,7 @@ class Player : public Unit
         uint8 m_grantableLevels;
 
         std::unordered_map<uint32, TimePoint> m_enteredInstances;
+        bool m_enteredInstancesChanged;
         uint32 m_createdInstanceClearTimer;
 
         uint32 m_pendingBindMapId;
@@ -317,6 +317,7 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procAuraFlags = 0;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -435,13 +436,16 @@ void Unit::Update(const uint32 diff)
     if (!IsInWorld())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("unit.update", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(GetEntry()) },
+            { "guid", std::to_string(GetGUIDLow()) },
+            { "unit_type", std::to_string(GetGUIDHigh()) },
+            { "map_id", std::to_string(GetMapId()) },
+            { "instance_id", std::to_string(GetInstanceId()) }
+        };
+    });
 #endif
 
     /*if(p_time > m_AurasCheck)
@@ -503,13 +507,16 @@ void Unit::Update(const uint32 diff)
     if (AI() && IsAlive())
     {
 #ifdef BUILD_METRICS
-        metric::duration<std::chrono::microseconds> meas_ai("unit.update.ai", {
-            { "entry", std::to_string(GetEntry()) },
-            { "guid", std::to_string(GetGUIDLow()) },
-            { "unit_type", std::to_string(GetGUIDHigh()) },
-            { "map_id", std::to_string(GetMapId()) },
-            { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
+        auto meas_ai = metric::make_threshold_duration<std::chrono::microseconds>("unit.update.ai", 1000, [&]
+        {
+            return std::map<std::string, std::string> {
+                { "entry", std::to_string(GetEntry()) },
+                { "guid", std::to_string(GetGUIDLow()) },
+                { "unit_type", std::to_string(GetGUIDHigh()) },
+                { "map_id", std::to_string(GetMapId()) },
+                { "instance_id", std::to_string(GetInstanceId()) }
+            };
+        });
 #endif
 
         AI()->UpdateAI(diff);   // AI not react good at real update delays (while freeze in non-active part of map)
@@ -4713,15 +4720,25 @@ uint32 Unit::GetWeaponSkillValue(WeaponAttackType attType, Unit const* target) c
 void Unit::_UpdateSpells(uint32 time)
 {
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update.spells", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
-
+    // declared first, the report below reads it on scope exit
     std::vector<uint32> updatedSpellIds;
+
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("unit.update.spells", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(GetEntry()) },
+            { "guid", std::to_string(GetGUIDLow()) },
+            { "unit_type", std::to_string(GetGUIDHigh()) },
+            { "map_id", std::to_string(GetMapId()) },
+            { "instance_id", std::to_string(GetInstanceId()) }
+        };
+    }, [&]
+    {
+        std::string logging;
+        for (uint32 spellId : updatedSpellIds)
+            logging += std::to_string(spellId) + ",";
+        return std::map<std::string, boost::any> { { "spells", "\"" + logging + "\"" } };
+    });
 #endif
 
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
@@ -4762,12 +4779,6 @@ void Unit::_UpdateSpells(uint32 time)
         else
             ++iter;
     }
-#ifdef BUILD_METRICS
-    std::string logging;
-    for (uint32 spellId : updatedSpellIds)
-        logging += std::to_string(spellId) + ",";
-    meas.add_field("spells", "\"" + logging + "\"");
-#endif
 }
 
 void Unit::_UpdateAutoRepeatSpell()
@@ -5570,6 +5581,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddProcAuraHolder(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -6201,6 +6213,34 @@ void Unit::RemoveNotOwnTrackedTargetAuras(uint32 newPhase)
     }
 }
 
+void Unit::AddProcAuraHolder(SpellAuraHolder* holder)
+{
+    uint32 procFlags = sSpellMgr.GetSpellProcFlags(holder->GetSpellProto());
+    if (!procFlags)
+        return;
+
+    // keep the same order as m_spellAuraHolders: by spell id, new holders after existing ones of the same spell
+    uint32 spellId = holder->GetId();
+    auto itr = std::upper_bound(m_procAuraHolders.begin(), m_procAuraHolders.end(), spellId,
+        [](uint32 id, ProcAuraHolderEntry const& entry) { return id < entry.holder->GetId(); });
+    m_procAuraHolders.insert(itr, { procFlags, holder });
+    m_procAuraFlags |= procFlags;
+}
+
+void Unit::RemoveProcAuraHolder(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_procAuraHolders.begin(), m_procAuraHolders.end(),
+        [holder](ProcAuraHolderEntry const& entry) { return entry.holder == holder; });
+    if (itr == m_procAuraHolders.end())
+        return;
+
+    m_procAuraHolders.erase(itr);
+
+    m_procAuraFlags = 0;
+    for (ProcAuraHolderEntry const& entry : m_procAuraHolders)
+        m_procAuraFlags |= entry.procFlags;
+}
+
 void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
 {
     MANGOS_ASSERT(!holder->IsDeleted());
@@ -6222,6 +6262,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            RemoveProcAuraHolder(holder);
             m_hasPeriodicAura = HasPeriodicAura();
             if (!m_hasPeriodicAura)
                 SetNextUpdateTime(0);
@@ -12915,13 +12956,16 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     if (movespline->Finalized())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.updatesplinemovement", {
-        { "entry", std::to_string(GetEntry()) },
-        { "guid", std::to_string(GetGUIDLow()) },
-        { "unit_type", std::to_string(GetGUIDHigh()) },
-        { "map_id", std::to_string(GetMapId()) },
-        { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("unit.updatesplinemovement", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(GetEntry()) },
+            { "guid", std::to_string(GetGUIDLow()) },
+            { "unit_type", std::to_string(GetGUIDHigh()) },
+            { "map_id", std::to_string(GetMapId()) },
+            { "instance_id", std::to_string(GetInstanceId()) }
+        };
+    });
 #endif
     movespline->updateState(t_diff);
     bool arrived = movespline->Finalized();
@@ -13393,14 +13437,18 @@ bool Unit::TakeCharmOf(Unit* charmed, uint32 spellId, bool advertised /*= true*/
         sLog.outCustomLog("Unit didnt equal in Unit::TakeCharmOf after attackability changes.");
 
     // put charmed in combat with all charmers enemies - must be done after flags
-    ThreatList const& list = getThreatManager().getThreatList();
-    for (auto& data : list)
+    // collected first, entering combat may change the threat list
+    std::vector<Unit*> enemies;
+    for (auto& data : getThreatManager().getThreatList())
     {
         Unit* enemy = data->getTarget();
         if (charmed->CanAttack(enemy))
-            charmed->AddThreat(enemy, 0.f);
+            enemies.push_back(enemy);
     }
 
+    for (Unit* enemy : enemies)
+        charmed->AddThreat(enemy, 0.f);
+
     if (!IsInCombat())
     {
         charmed->GetCombatManager().StopCombatTimer();
@@ -13744,11 +13792,13 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
+        target->m_events.ForEachEvent([this](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
                 if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
+        });
     }
 }
 
@@ -2049,6 +2049,8 @@ class Unit : public WorldObject
 
         bool AddSpellAuraHolder(SpellAuraHolder* holder);
         void AddAuraToModList(Aura* aura);
+        void AddProcAuraHolder(SpellAuraHolder* holder);
+        void RemoveProcAuraHolder(SpellAuraHolder* holder);
 
         // removing specific aura stack
         void RemoveAura(Aura* Aur, AuraRemoveMode mode = AURA_REMOVE_BY_DEFAULT);
@@ -2756,6 +2758,14 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        // holders that have proc flags, in m_spellAuraHolders order, so proc events do not need to walk every aura
+        struct ProcAuraHolderEntry
+        {
+            uint32 procFlags;
+            SpellAuraHolder* holder;
+        };
+        std::vector<ProcAuraHolderEntry> m_procAuraHolders;
+        uint32 m_procAuraFlags;                             // union of m_procAuraHolders proc flags
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
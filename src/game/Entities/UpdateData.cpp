@@ -65,29 +65,70 @@ void UpdateData::AddAfterCreatePacket(const WorldPacket& data)
     m_afterCreatePacket.emplace_back(data);
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+// deflate state is ~256KB, keep one per thread and reset it between packets instead of reallocating
+class DeflateStream
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    public:
+        DeflateStream() : m_level(-1)
+        {
+            m_stream.zalloc = (alloc_func)nullptr;
+            m_stream.zfree = (free_func)nullptr;
+            m_stream.opaque = (voidpf)nullptr;
+        }
+
+        ~DeflateStream()
+        {
+            if (m_level >= 0)
+                deflateEnd(&m_stream);
+        }
+
+        z_stream* Acquire(int level)
+        {
+            if (m_level == level)
+            {
+                if (deflateReset(&m_stream) == Z_OK)
+                    return &m_stream;
+            }
+
+            // first use on this thread or compression level changed by config reload
+            if (m_level >= 0)
+                deflateEnd(&m_stream);
+            m_level = -1;
+
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            m_level = level;
+            return &m_stream;
+        }
+
+    private:
+        z_stream m_stream;
+        int m_level;
+};
+
+static thread_local DeflateStream t_deflateStream;
 
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = t_deflateStream.Acquire(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -95,14 +136,14 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -110,58 +151,49 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
+    *dst_size = c_stream->total_out;
 }
 
-WorldPacket UpdateData::BuildPacket(size_t index)
+void UpdateData::CompressPacket(WorldPacket& packet)
 {
-    WorldPacket packet;
-    MANGOS_ASSERT(packet.empty());                         // shouldn't happen
+    size_t pSize = packet.wpos();                           // use real used data size
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data[index].m_buffer.wpos());
+    if (packet.GetOpcode() != SMSG_UPDATE_OBJECT || pSize <= sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD))
+        return;                                             // send small packets without compression
 
-    buf << (uint32)(!m_outOfRangeGUIDs.empty() ? m_data[index].m_blockCount + 1 : m_data[index].m_blockCount);
+    uint32 destsize = compressBound(pSize);
+    WorldPacket compressed(SMSG_COMPRESSED_UPDATE_OBJECT, 0);
+    compressed.resize(destsize + sizeof(uint32));
 
-    if (!m_outOfRangeGUIDs.empty())
-    {
-        buf << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
-        buf << (uint32) m_outOfRangeGUIDs.size();
+    compressed.put<uint32>(0, pSize);
+    Compress(const_cast<uint8*>(compressed.contents()) + sizeof(uint32), &destsize, (void*)packet.contents(), pSize);
+    if (destsize == 0)
+        return;                                             // keep it uncompressed, error already logged
 
-        for (auto m_outOfRangeGUID : m_outOfRangeGUIDs)
-            buf << m_outOfRangeGUID.WriteAsPacked();
-    }
+    compressed.resize(destsize + sizeof(uint32));
+    packet = std::move(compressed);
+}
 
-    buf.append(m_data[index].m_buffer);
+WorldPacket UpdateData::BuildPacket(size_t index, bool compress)
+{
+    WorldPacket packet(SMSG_UPDATE_OBJECT, 4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data[index].m_buffer.wpos());
 
-    size_t pSize = buf.wpos();                              // use real used data size
+    packet << (uint32)(!m_outOfRangeGUIDs.empty() ? m_data[index].m_blockCount + 1 : m_data[index].m_blockCount);
 
-    if (pSize > 100)                                        // compress large packets
+    if (!m_outOfRangeGUIDs.empty())
     {
-        uint32 destsize = compressBound(pSize);
-        packet.resize(destsize + sizeof(uint32));
-
-        packet.put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-        if (destsize == 0)
-            return packet;
+        packet << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
+        packet << (uint32) m_outOfRangeGUIDs.size();
 
-        packet.resize(destsize + sizeof(uint32));
-        packet.SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
-    }
-    else                                                    // send small packets without compression
-    {
-        packet.append(buf);
-        packet.SetOpcode(SMSG_UPDATE_OBJECT);
+        for (auto m_outOfRangeGUID : m_outOfRangeGUIDs)
+            packet << m_outOfRangeGUID.WriteAsPacked();
     }
 
+    packet.append(m_data[index].m_buffer);
+
+    if (compress)
+        CompressPacket(packet);
+
     return packet;
 }
 
@@ -176,10 +208,12 @@ void UpdateData::SendData(WorldSession& session)
     if (!HasData())
         return;
 
+    // optionally leave compression to the network thread owning the socket
+    bool compressInNetworkThread = sWorld.getConfig(CONFIG_BOOL_COMPRESSION_IN_NETWORK_THREAD);
     for (size_t i = 0; i < GetPacketCount(); ++i)
     {
-        WorldPacket packet = BuildPacket(i);
-        session.SendPacket(packet);
+        WorldPacket packet = BuildPacket(i, !compressInNetworkThread);
+        session.SendPacket(packet, compressInNetworkThread);
     }
 
     for (auto& packet : m_afterCreatePacket)
@@ -57,6 +57,15 @@ struct BufferPair
     uint32 m_blockCount;
 };
 
+// values blocks of one object built during a single update pass, keyed by viewer visibility class
+struct ValuesUpdateCache
+{
+    ValuesUpdateCache() : viewerDependent(false) {}
+
+    bool viewerDependent;                                   // some changed field is serialized differently per viewer
+    std::vector<std::pair<uint32, ByteBuffer>> blocks;
+};
+
 class UpdateData
 {
     public:
@@ -66,7 +75,7 @@ class UpdateData
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
         void AddAfterCreatePacket(const WorldPacket& data);
-        WorldPacket BuildPacket(size_t index); // Copy Elision is a thing
+        WorldPacket BuildPacket(size_t index, bool compress = true); // Copy Elision is a thing
         bool HasData() const { return m_data[0].m_buffer.size() > 0 || !m_outOfRangeGUIDs.empty(); }
         size_t GetPacketCount() const { return m_data.size(); }
         void Clear();
@@ -75,13 +84,17 @@ class UpdateData
 
         void SendData(WorldSession& session);
 
+        /// Turns SMSG_UPDATE_OBJECT above the configured threshold into SMSG_COMPRESSED_UPDATE_OBJECT
+        static void CompressPacket(WorldPacket& packet);
+
+        /// Deflates src into dst with the configured level, dst_size is set to 0 on failure
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+
     protected:
         GuidSet m_outOfRangeGUIDs;
         std::vector<BufferPair> m_data;
         uint32 m_currentIndex;
 
         std::vector<WorldPacket> m_afterCreatePacket;
-
-        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
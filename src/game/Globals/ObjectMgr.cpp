@@ -18,6 +18,7 @@
 
 #include "Globals/ObjectMgr.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/WorldSnapshot.h"
 #include "Policies/Singleton.h"
 
 #include "Server/SQLStorages.h"
@@ -265,7 +266,7 @@ void ObjectMgr::LoadCreatureLocales()
 {
     mCreatureLocaleMap.clear();                             // need for reload case
 
-    auto queryResult = WorldDatabase.Query("SELECT entry,name_loc1,subname_loc1,name_loc2,subname_loc2,name_loc3,subname_loc3,name_loc4,subname_loc4,name_loc5,subname_loc5,name_loc6,subname_loc6,name_loc7,subname_loc7,name_loc8,subname_loc8 FROM locales_creature");
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT entry,name_loc1,subname_loc1,name_loc2,subname_loc2,name_loc3,subname_loc3,name_loc4,subname_loc4,name_loc5,subname_loc5,name_loc6,subname_loc6,name_loc7,subname_loc7,name_loc8,subname_loc8 FROM locales_creature");
 
     if (!queryResult)
     {
@@ -2296,7 +2297,7 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
     //                                             0                       1   2
-    auto queryResult = WorldDatabase.Query("SELECT creature.guid, creature.id, map,"
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT creature.guid, creature.id, map,"
                           //        3           4           5            6                 7                 8          9
                           "position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist,"
                           //   10         11        12         13
@@ -2557,7 +2558,7 @@ void ObjectMgr::LoadGameObjects()
     uint32 count = 0;
 
     //                                             0                           1   2    3           4           5           6
-    auto queryResult = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           // 7        8          9          10         11                12                13         14         15
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecsmin, spawntimesecsmax, spawnMask, phaseMask, event,"
                           //   16                          17
@@ -2759,7 +2760,7 @@ void ObjectMgr::LoadGameObjects()
     sLog.outString(">> Loaded " SIZEFMTD " gameobjects", mGameObjectDataMap.size());
     sLog.outString();
 
-    queryResult = WorldDatabase.PQuery("SELECT guid, animprogress, state, stringId, path_rotation0, path_rotation1, path_rotation2, path_rotation3 FROM gameobject_addon");
+    queryResult = sWorldSnapshot.PQuery(WorldDatabase, "SELECT guid, animprogress, state, stringId, path_rotation0, path_rotation1, path_rotation2, path_rotation3 FROM gameobject_addon");
     do
     {
         Field* fields = queryResult->Fetch();
@@ -3048,7 +3049,7 @@ void ObjectMgr::LoadItemLocales()
 {
     mItemLocaleMap.clear();                                 // need for reload case
 
-    auto queryResult = WorldDatabase.Query("SELECT entry,name_loc1,description_loc1,name_loc2,description_loc2,name_loc3,description_loc3,name_loc4,description_loc4,name_loc5,description_loc5,name_loc6,description_loc6,name_loc7,description_loc7,name_loc8,description_loc8 FROM locales_item");
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT entry,name_loc1,description_loc1,name_loc2,description_loc2,name_loc3,description_loc3,name_loc4,description_loc4,name_loc5,description_loc5,name_loc6,description_loc6,name_loc7,description_loc7,name_loc8,description_loc8 FROM locales_item");
 
     if (!queryResult)
     {
@@ -5037,7 +5038,7 @@ void ObjectMgr::LoadQuests()
     m_ExclusiveQuestGroups.clear();
 
     //                                             0      1       2           3         4           5     6                7              8              9
-    auto queryResult = WorldDatabase.Query("SELECT entry, Method, ZoneOrSort, MinLevel, QuestLevel, Type, RequiredClasses, RequiredRaces, RequiredSkill, RequiredSkillValue,"
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT entry, Method, ZoneOrSort, MinLevel, QuestLevel, Type, RequiredClasses, RequiredRaces, RequiredSkill, RequiredSkillValue,"
                           //   10                   11                 12                     13                   14                     15                   16                17
                           "RepObjectiveFaction, RepObjectiveValue, RequiredMinRepFaction, RequiredMinRepValue, RequiredMaxRepFaction, RequiredMaxRepValue, SuggestedPlayers, LimitTime,"
                           //   18          19            20           21            22            23           24           25              26
@@ -5724,7 +5725,7 @@ void ObjectMgr::LoadQuestLocales()
 {
     mQuestLocaleMap.clear();                                // need for reload case
 
-    auto queryResult = WorldDatabase.Query("SELECT entry,"
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT entry,"
                           "Title_loc1,Details_loc1,Objectives_loc1,OfferRewardText_loc1,RequestItemsText_loc1,EndText_loc1,CompletedText_loc1,ObjectiveText1_loc1,ObjectiveText2_loc1,ObjectiveText3_loc1,ObjectiveText4_loc1,"
                           "Title_loc2,Details_loc2,Objectives_loc2,OfferRewardText_loc2,RequestItemsText_loc2,EndText_loc2,CompletedText_loc2,ObjectiveText1_loc2,ObjectiveText2_loc2,ObjectiveText3_loc2,ObjectiveText4_loc2,"
                           "Title_loc3,Details_loc3,Objectives_loc3,OfferRewardText_loc3,RequestItemsText_loc3,EndText_loc3,CompletedText_loc3,ObjectiveText1_loc3,ObjectiveText2_loc3,ObjectiveText3_loc3,ObjectiveText4_loc3,"
@@ -7616,7 +7617,7 @@ void ObjectMgr::LoadGameObjectLocales()
 {
     mGameObjectLocaleMap.clear();                           // need for reload case
 
-    auto queryResult = WorldDatabase.Query("SELECT entry,"
+    auto queryResult = sWorldSnapshot.Query(WorldDatabase, "SELECT entry,"
                           "name_loc1,name_loc2,name_loc3,name_loc4,name_loc5,name_loc6,name_loc7,name_loc8,"
                           "opening_text_loc1,opening_text_loc2,opening_text_loc3,opening_text_loc4,"
                           "opening_text_loc5,opening_text_loc6,opening_text_loc7,opening_text_loc8,"
@@ -156,12 +156,13 @@ void MessageDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
 
-void MessageDelivererExcept::Visit(CameraMapType& m)
+template<class SEND>
+void MessageDelivererExcept::Deliver(CameraMapType& m, SEND&& send) const
 {
     for (auto& iter : m)
     {
@@ -171,10 +172,20 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = owner->GetSession())
-            session->SendPacket(i_message);
+            send(session);
     }
 }
 
+void MessageDelivererExcept::Visit(CameraMapType& m)
+{
+    Deliver(m, [this](WorldSession* session) { i_message.SendTo(session); });
+}
+
+void MovementMessageDeliverer::Visit(CameraMapType& m)
+{
+    Deliver(m, [this](WorldSession* session) { session->SendMovementPacket(i_movement); });
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (auto& iter : m)
@@ -183,7 +194,7 @@ void ObjectMessageDeliverer::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = iter.getSource()->GetOwner()->GetSession())
-            session->SendPacket(i_message);
+            i_message.SendTo(session);
     }
 }
 
@@ -201,7 +212,7 @@ void MessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
@@ -216,7 +227,7 @@ void ObjectMessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = iter.getSource()->GetOwner()->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
@@ -63,7 +63,7 @@ namespace MaNGOS
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        PacketBroadcast i_message;
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket const& msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
@@ -73,7 +73,7 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket const& i_message;
+        PacketBroadcast i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket const& msg, Player const* skipped)
@@ -81,12 +81,28 @@ namespace MaNGOS
 
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+
+    protected:
+        // calls send for the session of every receiver in phase except the skipped one
+        template<class SEND> void Deliver(CameraMapType& m, SEND&& send) const;
+    };
+
+    // same receivers, but queues the packet for aggregated sending instead of sending it right away
+    struct MovementMessageDeliverer : public MessageDelivererExcept
+    {
+        WorldPacket const& i_movement;
+
+        MovementMessageDeliverer(WorldObject const* obj, WorldPacket const& msg, Player const* skipped)
+            : MessageDelivererExcept(obj, msg, skipped), i_movement(msg) {}
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket const& i_message;
+        PacketBroadcast i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket const& msg)
             : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
         void Visit(CameraMapType& m);
@@ -96,7 +112,7 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        PacketBroadcast i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -110,7 +126,7 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket const& i_message;
+        PacketBroadcast i_message;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket const& msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
@@ -817,6 +817,7 @@ void Group::UpdateOfflineLeader(time_t time, uint32 delay)
 
 void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore) const
 {
+    PacketBroadcast broadcast(packet);
     for (GroupReference const* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -824,7 +825,7 @@ void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRai
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            broadcast.SendTo(pl->GetSession());
     }
 }
 
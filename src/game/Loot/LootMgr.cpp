@@ -18,6 +18,7 @@
 
 #include "Loot/LootMgr.h"
 #include "Log/Log.h"
+#include "Database/WorldSnapshot.h"
 #include "Globals/ObjectMgr.h"
 #include "Util/ProgressBar.h"
 #include "World/World.h"
@@ -137,7 +138,7 @@ void LootStore::LoadLootTable()
     Clear();
 
     //                                                 0      1     2                    3        4              5         6
-    auto queryResult = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    auto queryResult = sWorldSnapshot.PQuery(WorldDatabase, "SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
 
     if (queryResult)
     {
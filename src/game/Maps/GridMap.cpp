@@ -29,6 +29,9 @@
 #include "Policies/Singleton.h"
 #include "Util/Util.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include <mutex>
 
 char const* MAP_MAGIC         = "MAPS";
@@ -40,6 +43,95 @@ char const* MAP_LIQUID_MAGIC  = "MLIQ";
 static uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
+// reads a .map file through stdio, or from a read-only mapping of the whole file
+// the mapping is stored in the given GridMap member, as loaded arrays point into it
+class GridMapSource
+{
+    public:
+        GridMapSource(char const* filename, std::unique_ptr<boost::interprocess::mapped_region>* mapping) : m_file(nullptr), m_region(nullptr), m_position(0)
+        {
+            if (!mapping)
+            {
+                m_file = fopen(filename, "rb");
+                return;
+            }
+
+            try
+            {
+                boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+                *mapping = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+                m_region = mapping->get();
+            }
+            catch (boost::interprocess::interprocess_exception const&)
+            {
+                mapping->reset();
+            }
+        }
+
+        ~GridMapSource()
+        {
+            if (m_file)
+                fclose(m_file);
+        }
+
+        bool IsOpen() const { return m_file || m_region; }
+
+        bool Seek(uint32 offset)
+        {
+            if (m_file)
+                return fseek(m_file, offset, SEEK_SET) == 0;
+
+            if (offset > m_region->get_size())
+                return false;
+
+            m_position = offset;
+            return true;
+        }
+
+        bool Read(void* dest, size_t size)
+        {
+            if (m_file)
+                return fread(dest, size, 1, m_file) == 1;
+
+            if (m_position + size > m_region->get_size())
+                return false;
+
+            memcpy(dest, static_cast<uint8 const*>(m_region->get_address()) + m_position, size);
+            m_position += size;
+            return true;
+        }
+
+        // points into the mapping when the data is suitably aligned, otherwise reads into a buffer kept in owned
+        template<class T>
+        T* ReadArray(size_t count, std::vector<std::unique_ptr<uint8[]>>& owned)
+        {
+            size_t size = count * sizeof(T);
+            if (m_region)
+            {
+                if (m_position + size > m_region->get_size())
+                    return nullptr;
+
+                uint8* data = static_cast<uint8*>(m_region->get_address()) + m_position;
+                if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+                {
+                    m_position += size;
+                    return reinterpret_cast<T*>(data);
+                }
+            }
+
+            owned.emplace_back(new uint8[size]);
+            if (!Read(owned.back().get(), size))
+                return nullptr;
+
+            return reinterpret_cast<T*>(owned.back().get());
+        }
+
+    private:
+        FILE* m_file;
+        boost::interprocess::mapped_region const* m_region;
+        size_t m_position;
+};
+
 GridMap::GridMap() : m_gridIntHeightMultiplier(0.0f)
 {
     m_flags = 0;
@@ -77,25 +169,24 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char const* filename)
+bool GridMap::loadData(char const* filename, bool memoryMapped /*= false*/)
 {
     // Unload old data if exist
     unloadData();
 
     GridMapFileHeader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    GridMapSource in(filename, memoryMapped ? &m_mappedFile : nullptr);
+    if (!in.IsOpen())
     {
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
         // its a valid error only in case of no vmap files are available too
         return true;
     }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
     {
         sLog.outError("Error loading GridMapFileHeader\n");
-        fclose(in);
         return false;
     }
 
@@ -107,7 +198,6 @@ bool GridMap::loadData(char const* filename)
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
             return false;
         }
 
@@ -115,7 +205,6 @@ bool GridMap::loadData(char const* filename)
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
             return false;
         }
 
@@ -123,7 +212,6 @@ bool GridMap::loadData(char const* filename)
         if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
 
@@ -131,38 +219,38 @@ bool GridMap::loadData(char const* filename)
         if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' has the wrong version. Please extract the mapfiles again with the latest extractors.", filename);
-    fclose(in);
     return false;
 }
 
 void GridMap::unloadData()
 {
-    if (m_area_map)    { delete[] m_area_map;    m_area_map = nullptr; }
-    if (m_V9)          { delete[] m_V9;          m_V9 = nullptr; }
-    if (m_V8)          { delete[] m_V8;          m_V8 = nullptr; }
-    if (m_liquidEntry) { delete[] m_liquidEntry; m_liquidEntry = nullptr; }
-    if (m_liquidFlags) { delete[] m_liquidFlags; m_liquidFlags = nullptr; }
-    if (m_liquid_map)  { delete[] m_liquid_map;  m_liquid_map = nullptr; }
-    if (m_holes)       { delete[] m_holes;       m_holes = nullptr; }
+    m_area_map = nullptr;
+    m_V9 = nullptr;
+    m_V8 = nullptr;
+    m_liquidEntry = nullptr;
+    m_liquidFlags = nullptr;
+    m_liquid_map = nullptr;
+    m_holes = nullptr;
+
+    m_ownedData.clear();
+    m_mappedFile.reset();
 
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapSource& in, uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
@@ -170,20 +258,20 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        if (fread(m_area_map, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        m_area_map = in.ReadArray<uint16>(16 * 16, m_ownedData);
+        if (!m_area_map)
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapSource& in, uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
@@ -193,30 +281,27 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16[129 * 129];
-            m_uint16_V8 = new uint16[128 * 128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
+            m_uint16_V9 = in.ReadArray<uint16>(129 * 129, m_ownedData);
+            m_uint16_V8 = in.ReadArray<uint16>(128 * 128, m_ownedData);
+            if (!m_uint16_V9 || !m_uint16_V8)
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8[129 * 129];
-            m_uint8_V8 = new uint8[128 * 128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
+            m_uint8_V9 = in.ReadArray<uint8>(129 * 129, m_ownedData);
+            m_uint8_V8 = in.ReadArray<uint8>(128 * 128, m_ownedData);
+            if (!m_uint8_V9 || !m_uint8_V8)
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float[129 * 129];
-            m_V8 = new float[128 * 128];
-            if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
-                    fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
+            m_V9 = in.ReadArray<float>(129 * 129, m_ownedData);
+            m_V8 = in.ReadArray<float>(128 * 128, m_ownedData);
+            if (!m_V9 || !m_V8)
                 return false;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -227,20 +312,20 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(GridMapSource& in, uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    m_holes = new uint16[16 * 16];
-    return fread(m_holes, sizeof(uint16), 16 * 16, in) == 16 * 16;
+    m_holes = in.ReadArray<uint16>(16 * 16, m_ownedData);
+    return m_holes != nullptr;
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(GridMapSource& in, uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(&header, sizeof(header)))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
@@ -255,19 +340,19 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        if (fread(m_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        m_liquidEntry = in.ReadArray<uint16>(16 * 16, m_ownedData);
+        if (!m_liquidEntry)
             return false;
 
-        m_liquidFlags = new uint8[16 * 16];
-        if (fread(m_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
+        m_liquidFlags = in.ReadArray<uint8>(16 * 16, m_ownedData);
+        if (!m_liquidFlags)
             return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float[m_liquid_width * m_liquid_height];
-        if (fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in) != size_t(m_liquid_width * m_liquid_height))
+        m_liquid_map = in.ReadArray<float>(m_liquid_width * m_liquid_height, m_ownedData);
+        if (!m_liquid_map)
             return false;
     }
 
@@ -720,9 +805,9 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
     {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
-            m_GridMaps[i][k] = nullptr;
-            m_GridRef[i][k] = 0;
-            m_GridMapsLoadAttempted[i][k] = false;
+            m_GridMaps[i][k].store(nullptr, std::memory_order_relaxed);
+            m_GridRef[i][k].store(0, std::memory_order_relaxed);
+            m_GridMapsLoadAttempted[i][k].store(false, std::memory_order_relaxed);
         }
     }
 
@@ -741,7 +826,10 @@ TerrainInfo::~TerrainInfo()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
         for (auto& m_GridMap : m_GridMaps)
-            delete m_GridMap[k];
+            delete m_GridMap[k].load(std::memory_order_relaxed);
+
+    for (GridMap* retired : m_retiredGrids)
+        delete retired;
 
     m_vmgr->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
@@ -756,11 +844,11 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, bool mapOnly /*= fals
     RefGrid(x, y);
 
     // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[x][y];
+    GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
     if (!pMap)
     {
         pMap = LoadMapAndVMap(x, y, mapOnly);
-        m_GridMapsLoadAttempted[x][y] = true;
+        m_GridMapsLoadAttempted[x][y].store(true, std::memory_order_release);
     }
 
     return pMap;
@@ -772,12 +860,12 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    if (m_GridMaps[x][y])
+    if (m_GridMaps[x][y].load(std::memory_order_acquire))
     {
         // decrease grid reference count...
         if (UnrefGrid(x, y) == 0)
         {
-            m_GridMapsLoadAttempted[x][y] = false;
+            m_GridMapsLoadAttempted[x][y].store(false, std::memory_order_release);
             // TODO: add your additional logic here
         }
     }
@@ -786,6 +874,11 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
 // call this method only
 void TerrainInfo::CleanUpGrids(const uint32 diff)
 {
+    // retired one world update ago, every map update which could have read them has finished since
+    for (GridMap* retired : m_retiredGrids)
+        delete retired;
+    m_retiredGrids.clear();
+
     i_timer.Update(diff);
     if (!i_timer.Passed())
         return;
@@ -794,17 +887,16 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         {
-            const int16& iRef = m_GridRef[x][y];
-            GridMap* pMap = m_GridMaps[x][y];
+            int16 iRef = m_GridRef[x][y].load(std::memory_order_acquire);
+            GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
 
-            // delete those GridMap objects which have refcount = 0
+            // retire those GridMap objects which have refcount = 0
             if (pMap && iRef == 0)
             {
-                m_GridMaps[x][y] = nullptr;
-                m_GridMapsLoadAttempted[x][y] = false;
-                // delete grid data if reference count == 0
-                pMap->unloadData();
-                delete pMap;
+                m_GridMaps[x][y].store(nullptr, std::memory_order_release);
+                m_GridMapsLoadAttempted[x][y].store(false, std::memory_order_release);
+                // a lookup may have loaded the pointer just before, keep the data until the next call
+                m_retiredGrids.push_back(pMap);
 
                 // unload VMAPS...
                 m_vmgr->unloadMap(m_mapId, x, y);
@@ -831,8 +923,7 @@ int TerrainInfo::RefGrid(const uint32& x, const uint32& y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    LOCK_GUARD _lock(m_refMutex);
-    return (m_GridRef[x][y] += 1);
+    return m_GridRef[x][y].fetch_add(1, std::memory_order_acq_rel) + 1;
 }
 
 int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
@@ -840,11 +931,13 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    int16& iRef = m_GridRef[x][y];
+    std::atomic<int16>& iRef = m_GridRef[x][y];
 
-    LOCK_GUARD _lock(m_refMutex);
-    if (iRef > 0)
-        return (iRef -= 1);
+    // never drop below zero
+    int16 current = iRef.load(std::memory_order_acquire);
+    while (current > 0)
+        if (iRef.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel))
+            return current - 1;
 
     return 0;
 }
@@ -1319,14 +1412,14 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y, bool loadOnlyMap /*=
     int gx = (int)(32 - x / SIZE_OF_GRIDS);                 // grid x
     int gy = (int)(32 - y / SIZE_OF_GRIDS);                 // grid y
 
-    // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[gx][gy];
-    if (!pMap && m_GridMapsLoadAttempted[gx][gy] == true)
+    // quick check if GridMap already loaded, resident grids are returned without any lock
+    GridMap* pMap = m_GridMaps[gx][gy].load(std::memory_order_acquire);
+    if (!pMap && m_GridMapsLoadAttempted[gx][gy].load(std::memory_order_acquire))
         return pMap;
     else if (!pMap || (!pMap->IsFullyLoaded() && !loadOnlyMap))
     {
         pMap = LoadMapAndVMap(gx, gy, loadOnlyMap);
-        m_GridMapsLoadAttempted[gx][gy] = true;
+        m_GridMapsLoadAttempted[gx][gy].store(true, std::memory_order_release);
     }
 
     return pMap;
@@ -1334,16 +1427,16 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y, bool loadOnlyMap /*=
 
 GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly /*= false*/)
 {
-    if ((m_GridMaps[x][y] && mapOnly) || m_vmgr->IsTileLoaded(m_mapId, x, y))
+    if ((m_GridMaps[x][y].load(std::memory_order_acquire) && mapOnly) || m_vmgr->IsTileLoaded(m_mapId, x, y))
     {
         // nothing to load here
-        return m_GridMaps[x][y];
+        return m_GridMaps[x][y].load(std::memory_order_acquire);
     }
 
     {
         LOCK_GUARD lock(m_mutex);
         // double checked lock pattern
-        if (!m_GridMaps[x][y])
+        if (!m_GridMaps[x][y].load(std::memory_order_acquire))
         {
             GridMap* map = new GridMap();
 
@@ -1353,20 +1446,21 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
             snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
 
-            if (!map->loadData(tmp))
+            if (!map->loadData(tmp, sWorld.getConfig(CONFIG_BOOL_MEMORY_MAPPED_MAPS)))
             {
                 sLog.outError("Error loading map file: %s", tmp);
                 //assert(false);
             }
 
             delete[] tmp;
-            m_GridMaps[x][y] = map;
+            // publish only fully constructed data
+            m_GridMaps[x][y].store(map, std::memory_order_release);
         }
     }
 
     // we'll load the rest later
     if (mapOnly)
-        return m_GridMaps[x][y];
+        return m_GridMaps[x][y].load(std::memory_order_acquire);
 
     if (!m_vmgr->IsTileLoaded(m_mapId, x, y))
     {
@@ -1389,10 +1483,11 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         }
     }
 
-    if (m_GridMaps[x][y])
-        m_GridMaps[x][y]->SetFullyLoaded();
+    GridMap* map = m_GridMaps[x][y].load(std::memory_order_acquire);
+    if (map)
+        map->SetFullyLoaded();
 
-    return  m_GridMaps[x][y];
+    return map;
 }
 
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= nullptr*/) const
@@ -27,7 +27,9 @@
 #include "Maps/GridMapDefines.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -42,6 +44,16 @@ namespace VMAP
     class IVMapManager;
 };
 
+namespace boost
+{
+    namespace interprocess
+    {
+        class mapped_region;
+    }
+}
+
+class GridMapSource;
+
 class GridMap
 {
     private:
@@ -81,13 +93,17 @@ class GridMap
 
         uint16* m_holes;
 
+        // arrays above point either into these buffers or into the read-only file mapping
+        std::vector<std::unique_ptr<uint8[]>> m_ownedData;
+        std::unique_ptr<boost::interprocess::mapped_region> m_mappedFile;
+
         // For fast check
-        bool m_fullyLoaded;
+        std::atomic<bool> m_fullyLoaded;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        bool loadAreaData(GridMapSource& in, uint32 offset, uint32 size);
+        bool loadHeightData(GridMapSource& in, uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(GridMapSource& in, uint32 offset, uint32 size);
+        bool loadHolesData(GridMapSource& in, uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -103,10 +119,11 @@ class GridMap
         GridMap();
         ~GridMap();
 
-        bool loadData(char const* filename);
+        // memoryMapped: map the file read-only instead of copying it, so the page cache shares it between processes
+        bool loadData(char const* filename, bool memoryMapped = false);
         void unloadData();
-        bool IsFullyLoaded() const { return m_fullyLoaded; }
-        void SetFullyLoaded() { m_fullyLoaded = true; }
+        bool IsFullyLoaded() const { return m_fullyLoaded.load(std::memory_order_acquire); }
+        void SetFullyLoaded() { m_fullyLoaded.store(true, std::memory_order_release); }
 
         static bool ExistMap(uint32 mapid, int gx, int gy);
         static bool ExistVMap(uint32 mapid, int gx, int gy);
@@ -194,19 +211,23 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         const uint32 m_mapId;
 
-        GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        bool m_GridMapsLoadAttempted[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        // published with release once loaded, so lookups of resident grids never lock
+        // unloaded grids are retired instead of deleted, a lookup may still hold the pointer it has just read
+        std::atomic<GridMap*> m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::atomic<bool> m_GridMapsLoadAttempted[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::atomic<int16> m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         // global garbage collection timer
         ShortIntervalTimer i_timer;
 
+        // unpublished by the previous CleanUpGrids call, deleted by the next one
+        std::vector<GridMap*> m_retiredGrids;
+
         VMAP::IVMapManager* m_vmgr;
 
         typedef std::mutex LOCK_TYPE;
         typedef std::lock_guard<LOCK_TYPE> LOCK_GUARD;
         LOCK_TYPE m_mutex;
-        LOCK_TYPE m_refMutex;
 };
 
 // class for managing TerrainData object and all sort of geometry querying operations
@@ -18,6 +18,7 @@
 
 #include "Maps/Map.h"
 #include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
 #include "Entities/Player.h"
 #include "Grids/GridNotifiers.h"
 #include "Log/Log.h"
@@ -275,11 +276,25 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
 #ifdef ENABLE_PLAYERBOTS
       m_activeZonesTimer(0), hasRealPlayers(false),
 #endif      
-      m_variableManager(this)
+      m_variableManager(this), m_lastUpdateDuration(0)
 {
     m_weatherSystem = new WeatherSystem(this);
     m_transportGuids.Set(sMapMgr.GetTransportCounter());
 
+#ifdef BUILD_METRICS
+    std::map<std::string, std::string> metricTags = {
+        { "map_id", std::to_string(i_id) },
+        { "instance_id", std::to_string(i_InstanceId) }
+    };
+    // milliseconds
+    std::vector<int64> updateBounds = { 1, 2, 5, 10, 20, 50, 100, 200, 500 };
+    m_updateMetric = metric::metric::instance().register_histogram("map.update", metricTags, updateBounds);
+    m_sessionUpdateMetric = metric::metric::instance().register_histogram("map.update.session", metricTags, updateBounds);
+    m_updatedObjectsMetric = metric::metric::instance().register_counter("map.update.objects", metricTags);
+    m_updatedSessionsMetric = metric::metric::instance().register_counter("map.update.sessions", metricTags);
+    m_pendingRespawnsMetric = metric::metric::instance().register_gauge("map.respawns.pending", metricTags);
+#endif
+
 #ifdef BUILD_ELUNA
     if (sElunaConfig->IsElunaEnabled() && sElunaConfig->ShouldMapLoadEluna(id))
         {
@@ -325,8 +340,10 @@ void Map::Initialize(bool loadInstanceData /*= true*/)
     auto mmap = MMAP::MMapFactory::createOrGetMMapManager();
     if (mmap->IsEnabled())
     {
-        mmap->loadMapInstance(sWorld.GetDataPath(), GetId(), GetInstanceId());
-        if (sWorld.getConfig(CONFIG_BOOL_PRELOAD_MMAP_TILES))
+        // preloaded instances of the same map read one shared navmesh until they change a tile
+        bool preload = sWorld.getConfig(CONFIG_BOOL_PRELOAD_MMAP_TILES);
+        mmap->loadMapInstance(sWorld.GetDataPath(), GetId(), GetInstanceId(), Instanceable() && preload);
+        if (preload)
             mmap->loadAllMapTiles(sWorld.GetDataPath(), GetId(), GetInstanceId());
     }
 
@@ -1075,10 +1092,7 @@ void Map::Update(const uint32& t_diff)
     if (IsUpdateObjectTick())
         ++m_clientUpdateTick;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::milliseconds> meas("map.update", {
-        { "map_id", std::to_string(i_id) },
-        { "instance_id", std::to_string(i_InstanceId) }
-});
+    metric::timer<std::chrono::milliseconds> meas(m_updateMetric.get());
 #endif
 
     m_curTime = time(nullptr);
@@ -1093,6 +1107,9 @@ void Map::Update(const uint32& t_diff)
 
     GetMessager().Execute(this);
     m_spawnManager.Update();
+#ifdef BUILD_METRICS
+    m_pendingRespawnsMetric->set(static_cast<int64>(m_spawnManager.GetPendingRespawnCount()));
+#endif
 
     /// update active cells around players and active objects
     resetMarkedCells();
@@ -1114,10 +1131,7 @@ void Map::Update(const uint32& t_diff)
     {
 #ifdef BUILD_METRICS
         uint32 updatedSessions = 0;
-        metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
-            { "map_id", std::to_string(i_id) },
-            { "instance_id", std::to_string(i_InstanceId) },
-            });
+        metric::timer<std::chrono::milliseconds> sessions_meas(m_sessionUpdateMetric.get());
 #endif
 
         for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -1134,7 +1148,7 @@ void Map::Update(const uint32& t_diff)
 #endif
         }
 #ifdef BUILD_METRICS
-        sessions_meas.add_field("count", std::to_string(static_cast<int32>(updatedSessions)));
+        m_updatedSessionsMetric->add(updatedSessions);
 #endif
     }
 
@@ -1415,9 +1429,11 @@ void Map::Update(const uint32& t_diff)
     uint64 count = PerformObjectUpdate(t_diff, objToUpdate);
 
 #ifdef BUILD_METRICS
-    meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    m_updatedObjectsMetric->add(static_cast<int64>(count));
 #endif
 
+    ProcessPathRequests();
+
     // Process necessary scripts
     if (!m_scriptSchedule.empty())
         ScriptsProcess();
@@ -1434,6 +1450,9 @@ void Map::Update(const uint32& t_diff)
             m_clientUpdateTick = 0;
     }
 
+    // after object updates so that creates reach the client before moves of the created objects
+    SendMovementUpdates();
+
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
@@ -1477,6 +1496,54 @@ uint64 Map::PerformObjectUpdate(uint32 t_diff, WorldObjectUnSet& objToUpdate)
     return count;
 }
 
+std::shared_ptr<PathRequest> Map::RequestPath(Unit const* owner, std::function<void(PathFinder&)> calculation)
+{
+    auto request = std::make_shared<PathRequest>(owner, std::move(calculation));
+
+    m_pathRequests.push_back(request);
+    return request;
+}
+
+void Map::ProcessPathRequests()
+{
+    if (m_pathRequests.empty())
+        return;
+
+    // skip requests the requester already dropped or whose owner is gone
+    std::vector<std::shared_ptr<PathRequest>> requests;
+    requests.swap(m_pathRequests);
+
+    auto batch = std::make_shared<PathRequestBatch>();
+    for (auto& request : requests)
+    {
+        if (request.use_count() == 1)
+            continue;
+
+        Unit* owner = GetUnit(request->GetOwnerGuid());
+        if (owner && owner->IsInWorld() && owner->GetMap() == this)
+            batch->requests.push_back(request.get());
+    }
+
+    if (batch->requests.empty())
+        return;
+
+    // nothing else runs on this map meanwhile, so the owners can be read from any thread
+    MapUpdater* updater = sMapMgr.GetUpdater();
+    if (updater && batch->requests.size() > 1)
+    {
+        size_t helpers = std::min(batch->requests.size() - 1, updater->GetThreadCount());
+        for (size_t i = 0; i < helpers; ++i)
+            updater->schedule_update(new PathRequestWorker(batch, *updater));
+    }
+
+    // helpers that start late find the batch exhausted and return at once
+    batch->Run();
+    batch->Wait();
+
+    // requests dropped meanwhile are destroyed here on the map thread, never on a helper
+    requests.clear();
+}
+
 void Map::Remove(Player* player, bool remove)
 {
 #ifdef BUILD_ELUNA
@@ -1495,6 +1562,9 @@ void Map::Remove(Player* player, bool remove)
     else
         player->RemoveFromWorld();
 
+    // queued moves belong to objects of this map, the client forgets them on leaving
+    player->GetSession()->ClearMovementPackets();
+
     m_objectsToClientUpdate.erase(player);
     m_objectsToClientCreateUpdate.erase({ player , player->GetObjectGuid() });
     m_objectsToClientMovementUpdate.erase(player);
@@ -3299,6 +3369,14 @@ void Map::SendObjectUpdates()
     }
 }
 
+void Map::SendMovementUpdates()
+{
+    // also runs with aggregation disabled so that a config reload does not strand queued moves
+    for (auto& itr : m_mapRefManager)
+        if (WorldSession* session = itr.getSource()->GetSession())
+            session->FlushMovementPackets(false);
+}
+
 Creature* Map::GetCreature(uint32 dbguid) const
 {
     auto itr = m_dbGuidObjects.find(std::make_pair(HIGHGUID_UNIT, dbguid));
@@ -3576,6 +3654,16 @@ bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float
            && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
 }
 
+void Map::IsInLineOfSight(VMAP::LineOfSightQuery const* queries, bool* results, uint32 count, uint32 phasemask, bool ignoreM2Model) const
+{
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), queries, results, count, ignoreM2Model);
+
+    // dynamic objects only for the rays static models did not block
+    for (uint32 i = 0; i < count; ++i)
+        if (results[i])
+            results[i] = m_dyn_tree.isInLineOfSight(queries[i].x1, queries[i].y1, queries[i].z1, queries[i].x2, queries[i].y2, queries[i].z2, phasemask, ignoreM2Model);
+}
+
 /**
  * get the hit position and return true if we hit something (in this case the dest position will hold the hit-position)
  * otherwise the result pos will be the dest pos
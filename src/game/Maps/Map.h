@@ -45,6 +45,10 @@
 #include "LuaEngine/ElunaMgr.h"
 #endif
 
+#ifdef BUILD_METRICS
+#include "Metric/Series.h"
+#endif
+
 #include <bitset>
 #include <functional>
 #include <list>
@@ -69,7 +73,10 @@ class GameObjectModel;
 class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
+namespace VMAP { struct LineOfSightQuery; }
 class Transport;
+class PathFinder;
+class PathRequest;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -167,6 +174,14 @@ class Map : public GridRefManager<NGridType>
 
         uint64 PerformObjectUpdate(uint32 t_diff, WorldObjectUnSet& objToUpdate);
 
+        // duration of the last threaded Update, used to schedule the longest maps first
+        uint32 GetLastUpdateDuration() const { return m_lastUpdateDuration; }
+        void SetLastUpdateDuration(uint32 duration) { m_lastUpdateDuration = duration; }
+
+        // calculation runs after all objects were updated, spread over the map update threads
+        // the result is ready on the owner's next update
+        std::shared_ptr<PathRequest> RequestPath(Unit const* owner, std::function<void(PathFinder&)> calculation);
+
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
         void MessageBroadcast(WorldObject const*, WorldPacket const&);
         void MessageDistBroadcast(Player const*, WorldPacket const&, float dist, bool to_self, bool own_team_only = false);
@@ -387,6 +402,8 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(uint32 phasemask, float x, float y, float z, bool swim = false) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const;
+        // many checks at once, static models are traversed in ray packets
+        void IsInLineOfSight(VMAP::LineOfSightQuery const* queries, bool* results, uint32 count, uint32 phasemask, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -553,6 +570,7 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateVisibility(UpdateDataMapType& update_players);
         void SendObjectUpdates();
+        void SendMovementUpdates();
         std::set<Object*> m_objectsToClientUpdate;
         std::set<std::pair<Object*, ObjectGuid>> m_objectsToClientCreateUpdate;
         std::set<Object*> m_objectsToClientMovementUpdate;
@@ -673,6 +691,20 @@ class Map : public GridRefManager<NGridType>
 
         std::map<std::pair<uint32, uint32>, uint32> m_tileNumberPerTile;
 
+        uint32 m_lastUpdateDuration;
+
+        void ProcessPathRequests();
+        std::vector<std::shared_ptr<PathRequest>> m_pathRequests;
+
+#ifdef BUILD_METRICS
+        // registered once per map, so the tick does not build tag strings
+        std::shared_ptr<metric::histogram> m_updateMetric;
+        std::shared_ptr<metric::histogram> m_sessionUpdateMetric;
+        std::shared_ptr<metric::counter> m_updatedObjectsMetric;
+        std::shared_ptr<metric::counter> m_updatedSessionsMetric;
+        std::shared_ptr<metric::gauge> m_pendingRespawnsMetric;
+#endif
+
 #ifdef BUILD_ELUNA
         ElunaInfo m_elunaInfo;
 #endif
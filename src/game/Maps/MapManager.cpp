@@ -206,16 +206,29 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (auto& map : i_maps)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
-    }
+        // workers are kept between ticks, one per map
+        while (m_updateWorkers.size() < i_maps.size())
+            m_updateWorkers.push_back(std::make_unique<MapUpdateWorker>(m_updater));
 
-    if (m_updater.activated())
+        std::vector<Worker*> workers;
+        workers.reserve(i_maps.size());
+        for (auto& map : i_maps)
+        {
+            MapUpdateWorker* worker = m_updateWorkers[workers.size()].get();
+            worker->Reset(map.second.get(), (uint32)i_timer.GetCurrent());
+            workers.push_back(worker);
+        }
+
+        m_updater.schedule_updates(workers);
         m_updater.wait();
+    }
+    else
+    {
+        for (auto& map : i_maps)
+            map.second->Update((uint32)i_timer.GetCurrent());
+    }
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -32,6 +32,7 @@
 
 class Transport;
 class BattleGround;
+class MapUpdateWorker;
 struct TransportTemplate;
 
 struct MapID
@@ -76,6 +77,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         void Initialize();
         void Update(uint32);
+        // pool updating the maps, null when maps are updated by the world thread
+        MapUpdater* GetUpdater() { return m_updater.activated() ? &m_updater : nullptr; }
 
         void SetGridCleanUpDelay(uint32 t)
         {
@@ -184,6 +187,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         std::atomic<uint32> i_MaxInstanceId;
         MapUpdater m_updater;
+        std::vector<std::unique_ptr<MapUpdateWorker>> m_updateWorkers;
         uint32 m_transportCounter;
 };
 
@@ -18,11 +18,19 @@
 
 #include "MapUpdater.h"
 #include "MapWorkers.h"
+#include "Util/Errors.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+#include <algorithm>
+
+MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0), _workEpoch(0), _nextQueue(0)
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    activate(num_threads);
+}
+
+MapUpdater::~MapUpdater()
+{
+    if (activated())
+        deactivate();
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -30,26 +38,43 @@ void MapUpdater::activate(size_t num_threads)
     if (activated())
         return;
 
+    _cancelationToken = false;
+
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _queue.Cancel();
+    ++_workEpoch;
+    _workEpoch.notify_all();
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    _workerThreads.clear();
+
+    for (auto& queue : _queues)
+        for (Worker* worker : queue->tasks)
+            if (!worker->IsPooled())
+                delete worker;
+
+    _queues.clear();
 }
 
 void MapUpdater::wait()
 {
-    std::unique_lock<std::mutex> lock(_lock);
-
-    while (pending_requests > 0)
-        _condition.wait(lock);
+    size_t pending = pending_requests.load(std::memory_order_acquire);
+    while (pending > 0)
+    {
+        pending_requests.wait(pending, std::memory_order_acquire);
+        pending = pending_requests.load(std::memory_order_acquire);
+    }
 }
 
 void MapUpdater::join()
@@ -65,36 +90,97 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    --pending_requests;
-    _condition.notify_all();
+    if (pending_requests.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        pending_requests.notify_all();
 }
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    MANGOS_ASSERT(!_queues.empty());                        // no queue to push to before activate()
 
     ++pending_requests;
-    _queue.Push(std::move(worker));
+    Push(_nextQueue++ % _queues.size(), worker);
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::schedule_updates(std::vector<Worker*>& workers)
 {
-    while (true)
+    MANGOS_ASSERT(!_queues.empty());
+
+    // longest job first - the biggest maps start right away instead of ending the tick alone
+    std::stable_sort(workers.begin(), workers.end(), [](Worker const* left, Worker const* right)
     {
-        Worker* request = nullptr;
+        return left->GetCost() > right->GetCost();
+    });
 
-        _queue.WaitAndPop(request);
+    pending_requests += workers.size();
 
-        if (_cancelationToken)
+    // dealt out round robin, so every queue stays ordered from its longest to its shortest job
+    for (size_t i = 0; i < workers.size(); ++i)
+        Push(i % _queues.size(), workers[i]);
+}
+
+void MapUpdater::Push(size_t queueIndex, Worker* worker)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queues[queueIndex]->lock);
+        _queues[queueIndex]->tasks.push_back(worker);
+    }
+
+    ++_workEpoch;
+    _workEpoch.notify_one();
+}
+
+bool MapUpdater::PopOrSteal(size_t queueIndex, Worker*& worker)
+{
+    {
+        WorkerQueue& own = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.tasks.empty())
         {
-            delete request;
+            worker = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < _queues.size(); ++i)
+    {
+        WorkerQueue& victim = *_queues[(queueIndex + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            worker = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MapUpdater::WorkerThread(size_t queueIndex)
+{
+    while (true)
+    {
+        // read epoch before looking for work, a push after the check changes it and wait returns at once
+        uint32 epoch = _workEpoch.load(std::memory_order_acquire);
+
+        if (_cancelationToken)
             return;
+
+        Worker* request = nullptr;
+        if (!PopOrSteal(queueIndex, request))
+        {
+            _workEpoch.wait(epoch, std::memory_order_acquire);
+            continue;
         }
 
+        // pooled workers can be reused by their owner as soon as they report finished, do not touch them after execute
+        bool pooled = request->IsPooled();
+
         request->execute();
 
-        delete request;
+        if (!pooled)
+            delete request;
     }
-}
\ No newline at end of file
+}
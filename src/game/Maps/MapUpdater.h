@@ -20,42 +20,57 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "Util/ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
-#include <condition_variable>
 
 class Worker;
 
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), pending_requests(0), _workEpoch(0), _nextQueue(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
-        
+        ~MapUpdater();
+
         void activate(size_t num_threads);
         void deactivate();
         void wait();
         void join();
         bool activated();
+        size_t GetThreadCount() const { return _workerThreads.size(); }
         void update_finished();
         void schedule_update(Worker* worker);
+        // schedules a whole batch longest job first, spread over the thread queues
+        void schedule_updates(std::vector<Worker*>& workers);
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        // every thread pops from the front of its own queue and steals from the back of the others when idle
+        // the queues are not lock free: each one is a plain deque behind its own mutex, so a push or pop only
+        // contends with a thread stealing from that same queue, never with the whole pool
+        struct WorkerQueue
+        {
+            std::mutex lock;
+            std::deque<Worker*> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
-        std::mutex _lock;
-        std::condition_variable _condition;
-        size_t pending_requests;
+        std::atomic<size_t> pending_requests;
+        std::atomic<uint32> _workEpoch;                     // bumped on every push, idle threads sleep on it
+        std::atomic<size_t> _nextQueue;
 
-        void WorkerThread();
+        void Push(size_t queueIndex, Worker* worker);
+        bool PopOrSteal(size_t queueIndex, Worker*& worker);
+        void WorkerThread(size_t queueIndex);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
@@ -23,38 +23,58 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
+#include <chrono>
+
 class Worker
 {
     public:
-        Worker(MapUpdater& updater) : m_updater(updater) {}
+        Worker(MapUpdater& updater, bool pooled = false) : m_updater(updater), m_pooled(pooled) {}
         virtual ~Worker() = default;
         virtual void execute() {};
 
+        // expected run time in ms, the updater starts the most expensive workers first
+        virtual uint32 GetCost() const { return 0; }
+        // pooled workers are owned and reused by whoever scheduled them, the updater does not delete them
+        bool IsPooled() const { return m_pooled; }
+
     protected:
         MapUpdater& GetWorker() { return m_updater; }
 
     private:
         MapUpdater& m_updater;
+        bool m_pooled;
 };
 
 class MapUpdateWorker : public Worker
 {
     public:
-        MapUpdateWorker(Map& map, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_diff(diff)
+        MapUpdateWorker(MapUpdater& updater) :
+            Worker(updater, true), m_map(nullptr), m_diff(0)
         {}
 
+        void Reset(Map* map, uint32 diff)
+        {
+            m_map = map;
+            m_diff = diff;
+        }
+
         void execute() override
         {
-            m_map.Update(m_diff);
+            auto start = std::chrono::steady_clock::now();
+            m_map->Update(m_diff);
+            m_map->SetLastUpdateDuration(uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()));
+
             GetWorker().update_finished();
         }
 
+        uint32 GetCost() const override { return m_map->GetLastUpdateDuration(); }
+
     private:
-        Map& m_map;
+        Map* m_map;
         uint32 m_diff;
 };
 
@@ -87,6 +107,54 @@ class GridCrawler : public Worker
         uint32 m_diff;
 };
 
+// requests are claimed one by one, the map thread calculates alongside the helpers and waits for the last one
+// the map thread owns the requests and releases them after Wait, a helper starting late only touches the cursor
+struct PathRequestBatch
+{
+    PathRequestBatch() : next(0), done(0) {}
+
+    void Run()
+    {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < requests.size(); i = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            requests[i]->Calculate();
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == requests.size())
+                done.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        size_t finished = done.load(std::memory_order_acquire);
+        while (finished < requests.size())
+        {
+            done.wait(finished, std::memory_order_acquire);
+            finished = done.load(std::memory_order_acquire);
+        }
+    }
+
+    std::vector<PathRequest*> requests;
+    std::atomic<size_t> next;
+    std::atomic<size_t> done;
+};
+
+class PathRequestWorker : public Worker
+{
+    public:
+        PathRequestWorker(std::shared_ptr<PathRequestBatch> batch, MapUpdater& updater) :
+            Worker(updater), m_batch(std::move(batch))
+        {}
+
+        void execute() override
+        {
+            m_batch->Run();
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::shared_ptr<PathRequestBatch> m_batch;
+};
 
 class ObjectUpdateWorker : public Worker
 {
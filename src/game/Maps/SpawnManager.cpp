@@ -110,71 +110,55 @@ void SpawnManager::Initialize()
 void SpawnManager::AddCreature(uint32 dbguid)
 {
     time_t respawnTime = m_map.GetPersistentState()->GetCreatureRespawnTime(dbguid);
-    if (m_updated)
-        m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT);
-    else
-        m_spawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT);
+    AddSpawn(SpawnInfo(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT));
 }
 
 void SpawnManager::AddGameObject(uint32 dbguid)
 {
     time_t respawnTime = m_map.GetPersistentState()->GetGORespawnTime(dbguid);
-    if (m_updated)
-        m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT);
-    else
-        m_spawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT);
+    AddSpawn(SpawnInfo(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT));
 }
 
 void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+
+    auto itr = std::find_if(m_spawns.begin(), m_spawns.end(), [dbguid](SpawnInfo const& spawnInfo)
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
-    }
-    if (!found)
+        return !spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT;
+    });
+    if (itr == m_spawns.end())
     {
-        m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
         AddCreature(dbguid);
+        return;
     }
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+
+    // the heap entry cannot be moved, it is replaced by a new one instead
+    MarkStale(*itr);
+    SpawnInfo spawnInfo(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_UNIT);
+    if (respawnDelay > 0 || !spawnInfo.ConstructForMap(m_map))
+        AddSpawn(std::move(spawnInfo));
 }
 
 void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+
+    auto itr = std::find_if(m_spawns.begin(), m_spawns.end(), [dbguid](SpawnInfo const& spawnInfo)
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
-    }
-    if (!found)
+        return !spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT;
+    });
+    if (itr == m_spawns.end())
     {
-        m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
         AddGameObject(dbguid);
+        return;
     }
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+
+    // the heap entry cannot be moved, it is replaced by a new one instead
+    MarkStale(*itr);
+    SpawnInfo spawnInfo(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_GAMEOBJECT);
+    if (respawnDelay > 0 || !spawnInfo.ConstructForMap(m_map))
+        AddSpawn(std::move(spawnInfo));
 }
 
 void SpawnManager::RemoveSpawns(std::vector<uint32> const& creatureDbGuids, std::vector<uint32> const& goDbGuids)
@@ -185,11 +169,11 @@ void SpawnManager::RemoveSpawns(std::vector<uint32> const& creatureDbGuids, std:
         {
             case HIGHGUID_GAMEOBJECT:
                 if (std::find(goDbGuids.begin(), goDbGuids.end(), spawnInfo.GetDbGuid()) != goDbGuids.end())
-                    spawnInfo.SetUsed(); // will be erased on next manager update
+                    MarkStale(spawnInfo); // will be erased when it reaches the top of the heap
                 break;
             case HIGHGUID_UNIT:
                 if (std::find(creatureDbGuids.begin(), creatureDbGuids.end(), spawnInfo.GetDbGuid()) != creatureDbGuids.end())
-                    spawnInfo.SetUsed(); // will be erased on next manager update
+                    MarkStale(spawnInfo); // will be erased when it reaches the top of the heap
                 break;
             default: break;
         }
@@ -202,7 +186,7 @@ void SpawnManager::RemoveSpawn(uint32 dbguid, HighGuid high)
     {
         if (spawnInfo.GetHighGuid() == high && spawnInfo.GetDbGuid() == dbguid)
         {
-            spawnInfo.SetUsed(); // will be erased on next manager update
+            MarkStale(spawnInfo); // will be erased when it reaches the top of the heap
             break;
         }
     }
@@ -239,11 +223,37 @@ bool SpawnManager::IsEventGuid(uint32 dbguid, HighGuid high) const
     return false;
 }
 
+void SpawnManager::AddSpawn(SpawnInfo&& spawnInfo)
+{
+    if (m_updated) // cannot insert during update
+    {
+        m_deferredSpawns.push_back(std::move(spawnInfo));
+        return;
+    }
+
+    m_spawns.push_back(std::move(spawnInfo));
+    std::push_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
+}
+
+void SpawnManager::MarkStale(SpawnInfo& spawnInfo)
+{
+    if (spawnInfo.IsUsed())
+        return;
+
+    spawnInfo.SetUsed();
+    ++m_staleCount;
+}
+
 void SpawnManager::RespawnAll()
 {
     for (auto itr = m_spawns.begin(); itr != m_spawns.end(); )
     {
         auto& spawnInfo = *itr;
+        if (spawnInfo.IsUsed())
+        {
+            itr = m_spawns.erase(itr);
+            continue;
+        }
         if (spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
             m_map.GetPersistentState()->SaveGORespawnTime(spawnInfo.GetDbGuid(), 0);
         if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
@@ -253,26 +263,49 @@ void SpawnManager::RespawnAll()
         else
             ++itr;
     }
+    m_staleCount = 0;
+    std::make_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
 }
 
 void SpawnManager::Update()
 {
     m_updated = true;
-    if (!m_deferredSpawns.empty()) // cannot insert during update
+    for (auto& spawnInfo : m_deferredSpawns)
     {
-        m_spawns.reserve(m_spawns.size() + m_deferredSpawns.size());
-        std::move(std::begin(m_deferredSpawns), std::end(m_deferredSpawns), std::back_inserter(m_spawns));
-        m_deferredSpawns.clear();
+        m_spawns.push_back(std::move(spawnInfo));
+        std::push_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
     }
+    m_deferredSpawns.clear();
+
+    // only spawns that are due are visited, failed ones are retried next tick
+    std::vector<SpawnInfo> failedSpawns;
     auto now = m_map.GetCurrentClockTime();
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    while (!m_spawns.empty())
     {
-        auto& spawnInfo = *itr;
-        if (spawnInfo.IsUsed() ||
-            (spawnInfo.GetRespawnTime() <= now && spawnInfo.ConstructForMap(m_map)))
-            itr = m_spawns.erase(itr);
-        else
-            ++itr;
+        auto& spawnInfo = m_spawns.front();
+        if (spawnInfo.IsUsed())
+            --m_staleCount;
+        else if (spawnInfo.GetRespawnTime() > now)
+            break;
+        else if (!spawnInfo.ConstructForMap(m_map))
+            failedSpawns.push_back(spawnInfo);
+
+        std::pop_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
+        m_spawns.pop_back();
+    }
+
+    for (auto& spawnInfo : failedSpawns)
+    {
+        m_spawns.push_back(std::move(spawnInfo));
+        std::push_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
+    }
+
+    // removed spawns far in the future would otherwise stay until their respawn time
+    if (m_staleCount > 64 && m_staleCount * 2 > m_spawns.size())
+    {
+        m_spawns.erase(std::remove_if(m_spawns.begin(), m_spawns.end(), [](SpawnInfo const& spawnInfo) { return spawnInfo.IsUsed(); }), m_spawns.end());
+        std::make_heap(m_spawns.begin(), m_spawns.end(), RespawnsLater);
+        m_staleCount = 0;
     }
     m_updated = false;
 
@@ -283,8 +316,12 @@ void SpawnManager::Update()
 
 std::string SpawnManager::GetRespawnList()
 {
+    std::vector<SpawnInfo> spawns;
+    std::copy_if(m_spawns.begin(), m_spawns.end(), std::back_inserter(spawns), [](SpawnInfo const& spawnInfo) { return !spawnInfo.IsUsed(); });
+    std::sort(spawns.begin(), spawns.end());
+
     std::string output = "";
-    for (auto& data : m_spawns)
+    for (auto& data : spawns)
     {
         output += "DBGuid: " + std::to_string(data.GetDbGuid()) + "HighGuid: " + (data.GetHighGuid() == HIGHGUID_UNIT ? "Creature" : "GameObject") + "Respawn Time ";
         auto diff = (data.GetRespawnTime() - m_map.GetCurrentClockTime()).count();
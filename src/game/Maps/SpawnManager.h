@@ -51,7 +51,7 @@ bool operator<(SpawnInfo const& lhs, SpawnInfo const& rhs);
 class SpawnManager
 {
     public:
-        SpawnManager(Map& map) : m_map(map), m_updated(false) {}
+        SpawnManager(Map& map) : m_map(map), m_updated(false), m_staleCount(0) {}
         ~SpawnManager();
         void Initialize();
 
@@ -74,17 +74,25 @@ class SpawnManager
         void Update();
 
         std::string GetRespawnList();
+        size_t GetPendingRespawnCount() const { return m_spawns.size() - m_staleCount + m_deferredSpawns.size(); }
 
         SpawnGroup* GetSpawnGroup(uint32 Id);
 
         void RespawnSpawnGroupsInVicinity(Position pos, float range);
     private:
+        static bool RespawnsLater(SpawnInfo const& lhs, SpawnInfo const& rhs) { return rhs < lhs; }
+
+        void AddSpawn(SpawnInfo&& spawnInfo);
+        void MarkStale(SpawnInfo& spawnInfo);
+
         Map& m_map;
 
         std::vector<SpawnInfo> m_deferredSpawns;
+        // min-heap on respawn time, removed spawns are only flagged used and dropped when they reach the top
         std::vector<SpawnInfo> m_spawns; // must only be erased from in Update
         std::map<uint32, SpawnGroup*> m_spawnGroups;
         bool m_updated;
+        size_t m_staleCount;                                // used entries still in m_spawns
 
         std::set<uint32> m_eventCreatureDbGuids;
         std::set<uint32> m_eventGoDbGuids;
@@ -59,13 +59,16 @@ inline bool isStatic(MovementGenerator* mv)
 void MotionMaster::Initialize()
 {
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("motionmaster.initialize", {
-        { "entry", std::to_string(m_owner->GetEntry()) },
-        { "guid", std::to_string(m_owner->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_owner->GetMapId()) },
-        { "instance_id", std::to_string(m_owner->GetInstanceId()) }
-    }, 1000);
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("motionmaster.initialize", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(m_owner->GetEntry()) },
+            { "guid", std::to_string(m_owner->GetGUIDLow()) },
+            { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
+            { "map_id", std::to_string(m_owner->GetMapId()) },
+            { "instance_id", std::to_string(m_owner->GetInstanceId()) }
+        };
+    });
 #endif
     // stop current move
     m_owner->StopMoving();
@@ -119,13 +122,16 @@ void MotionMaster::UpdateMotion(uint32 diff)
     if (m_owner->hasUnitState(UNIT_STAT_CAN_NOT_MOVE))
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("motionmaster.updatemotion", {
-        { "entry", std::to_string(m_owner->GetEntry()) },
-        { "guid", std::to_string(m_owner->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_owner->GetMapId()) },
-        { "instance_id", std::to_string(m_owner->GetInstanceId()) }
-    }, 1000);
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("motionmaster.updatemotion", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(m_owner->GetEntry()) },
+            { "guid", std::to_string(m_owner->GetGUIDLow()) },
+            { "unit_type", std::to_string(m_owner->GetGUIDHigh()) },
+            { "map_id", std::to_string(m_owner->GetMapId()) },
+            { "instance_id", std::to_string(m_owner->GetInstanceId()) }
+        };
+    });
 #endif
 
     MANGOS_ASSERT(!empty());
@@ -98,20 +98,49 @@ namespace MMAP
     {
         // by now we should not have maps loaded
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
+
+        // shared meshes report their tiles back on release
+        m_loadedMMaps.clear();
     }
 
     void MMapManager::ChangeTile(std::string const& basePath, uint32 mapId, uint32 instanceId, uint32 tileX, uint32 tileY, uint32 tileNumber)
     {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr != m_loadedMMaps.end() && itr->second->sharedMesh)
+            if (!detachSharedMesh(basePath, mapId, instanceId, *itr->second))
+                return;
+
         unloadMap(mapId, instanceId, tileX, tileY);
         loadMap(basePath, mapId, instanceId, tileX, tileY, tileNumber);
     }
 
-    bool MMapManager::loadMapData(std::string const& basePath, uint32 mapId, uint32 instanceId)
+    bool MMapManager::loadMapData(std::string const& basePath, uint32 mapId, uint32 instanceId, bool shareTiles)
     {
         // we already have this map loaded?
         if (m_loadedMMaps.find(packInstanceId(mapId, instanceId)) != m_loadedMMaps.end())
             return true;
 
+        if (shareTiles)
+        {
+            std::shared_ptr<MMapSharedMesh> shared = getSharedMesh(basePath, mapId);
+            if (!shared)
+                return false;
+
+            m_loadedMMaps.emplace(packInstanceId(mapId, instanceId), std::make_unique<MMapData>(std::move(shared)));
+            return true;
+        }
+
+        dtNavMesh* mesh = createNavMesh(basePath, mapId);
+        if (!mesh)
+            return false;
+
+        // store inside our map list
+        m_loadedMMaps.emplace(packInstanceId(mapId, instanceId), std::make_unique<MMapData>(mesh));
+        return true;
+    }
+
+    dtNavMesh* MMapManager::createNavMesh(std::string const& basePath, uint32 mapId)
+    {
         // load and init dtNavMesh - read parameters from file
         uint32 pathLen = basePath.length() + strlen(MAP_FILE_NAME_FORMAT) + 1;
         char* fileName = new char[pathLen];
@@ -123,7 +152,7 @@ namespace MMAP
             if (MMapFactory::IsPathfindingEnabled(mapId))
                 sLog.outError("MMAP:loadMapData: Error: Could not open mmap file '%s'", fileName);
             delete[] fileName;
-            return false;
+            return nullptr;
         }
 
         dtNavMeshParams params;
@@ -138,15 +167,80 @@ namespace MMAP
             dtFreeNavMesh(mesh);
             sLog.outError("MMAP:loadMapData: Failed to initialize dtNavMesh for mmap %03u from file %s", mapId, fileName);
             delete[] fileName;
-            return false;
+            return nullptr;
         }
 
         delete[] fileName;
 
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
+        return mesh;
+    }
 
-        // store inside our map list
-        m_loadedMMaps.emplace(packInstanceId(mapId, instanceId), std::make_unique<MMapData>(mesh));
+    std::shared_ptr<MMapSharedMesh> MMapManager::getSharedMesh(std::string const& basePath, uint32 mapId)
+    {
+        std::lock_guard<std::mutex> guard(m_sharedMeshesMutex);
+
+        std::weak_ptr<MMapSharedMesh>& cached = m_sharedMeshes[mapId];
+        if (std::shared_ptr<MMapSharedMesh> shared = cached.lock())
+            return shared;
+
+        dtNavMesh* mesh = createNavMesh(basePath, mapId);
+        if (!mesh)
+            return nullptr;
+
+        // the mesh is filled once here and never changed afterwards, so instances can query it from their own threads
+        // only maps that preload their tiles ask for it, lazily loaded meshes stay private
+        std::shared_ptr<MMapSharedMesh> shared(new MMapSharedMesh(mesh), [this](MMapSharedMesh* sharedMesh)
+        {
+            m_loadedTiles -= sharedMesh->loadedTiles.size();
+            delete sharedMesh;
+        });
+        loadAllTiles(basePath, mapId, mesh, shared->loadedTiles);
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:getSharedMesh: Loaded shared navmesh for %03u with %u tiles", mapId, uint32(shared->loadedTiles.size()));
+        cached = shared;
+        return shared;
+    }
+
+    bool MMapManager::detachSharedMesh(std::string const& basePath, uint32 mapId, uint32 instanceId, MMapData& mmapData)
+    {
+        // this instance needs its own tiles, give it a private copy of the default ones first
+        dtNavMesh* mesh = createNavMesh(basePath, mapId);
+        if (!mesh)
+            return false;
+
+        MMapTileSet loadedTiles;
+        for (auto const& tile : mmapData.sharedMesh->loadedTiles)
+        {
+            int32 x = int32(tile.first >> 16);
+            int32 y = int32(tile.first & 0x0000FFFF);
+
+            uint32 pathLen = basePath.length() + strlen(TILE_FILE_NAME_FORMAT) + 1;
+            std::unique_ptr<char[]> fileName(new char[pathLen]);
+            snprintf(fileName.get(), pathLen, (basePath + TILE_FILE_NAME_FORMAT).c_str(), mapId, x, y);
+            loadMapInternal(fileName.get(), mesh, loadedTiles, tile.first, mapId, x, y);
+        }
+
+        std::unique_lock<std::shared_mutex> meshGuard(mmapData.navMeshLock);
+        std::unique_lock<std::shared_mutex> queriesGuard(mmapData.queriesLock);
+
+        // rebind the queries of all threads, keeping their node pools
+        for (auto itr = mmapData.navMeshQueries.begin(); itr != mmapData.navMeshQueries.end();)
+        {
+            if (dtStatusFailed(itr->second->init(mesh, 1024)))
+            {
+                dtFreeNavMeshQuery(itr->second);
+                itr = mmapData.navMeshQueries.erase(itr);
+            }
+            else
+                ++itr;
+        }
+
+        mmapData.navMesh = mesh;
+        mmapData.mmapLoadedTiles = std::move(loadedTiles);
+        mmapData.sharedMesh.reset();
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:detachSharedMesh: mapId %03u instanceId %u now uses its own navmesh", mapId, instanceId);
         return true;
     }
 
@@ -186,10 +280,22 @@ namespace MMAP
         if (mmapData->fullLoaded)
             return;
 
+        std::unique_lock<std::shared_mutex> meshGuard(mmapData->navMeshLock);
+        loadAllTiles(basePath, mapId, mmapData->navMesh, mmapData->mmapLoadedTiles);
+
+        mmapData->fullLoaded = true;
+    }
+
+    void MMapManager::loadAllTiles(std::string const& basePath, uint32 mapId, dtNavMesh* navMesh, MMapTileSet& loadedTiles)
+    {
         for (const auto& entry : boost::filesystem::directory_iterator(basePath + "mmaps"))
         {
             if (entry.path().extension() == ".mmtile")
             {
+                // only default tiles MMMXXYY, alternative ones MMMXXYY_NN occupy the same position
+                if (entry.path().stem().string().length() != 7)
+                    continue;
+
                 auto filename = entry.path().filename();
                 auto fileNameString = filename.c_str();
                 // trying to avoid string copy
@@ -200,11 +306,9 @@ namespace MMAP
                 uint32 x = (fileNameString[3] - '0') * 10 + (fileNameString[4] - '0');
                 uint32 y = (fileNameString[5] - '0') * 10 + (fileNameString[6] - '0');
                 uint32 packedGridPos = packTileID(x, y);
-                loadMapInternal(entry.path().string().c_str(), mmapData, packedGridPos, mapId, x, y); // yes using a temporary - wchar_t on windows
+                loadMapInternal(entry.path().string().c_str(), navMesh, loadedTiles, packedGridPos, mapId, x, y); // yes using a temporary - wchar_t on windows
             }
         }
-
-        mmapData->fullLoaded = true;
     }
 
     bool MMapManager::loadMap(std::string const& basePath, uint32 mapId, uint32 instanceId, int32 x, int32 y, uint32 number)
@@ -215,6 +319,13 @@ namespace MMAP
 
         const auto& mmapData = itr->second;
 
+        // shared mesh already holds every default tile and other instances are searching it, ChangeTile detaches the instance first
+        if (mmapData->sharedMesh)
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Asked to load tile %03u%02i%02i.mmtile into shared navmesh of instance %u", mapId, x, y, instanceId);
+            return false;
+        }
+
         // check if we already have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmapData->mmapLoadedTiles.find(packedGridPos) != mmapData->mmapLoadedTiles.end())
@@ -228,10 +339,11 @@ namespace MMAP
         std::unique_ptr<char[]> fileName(new char[pathLen]);
         snprintf(fileName.get(), pathLen, (basePath + (number == 0 ? TILE_FILE_NAME_FORMAT : TILE_ALT_FILE_NAME_FORMAT)).c_str(), mapId, x, y);
 
-        return loadMapInternal(fileName.get(), mmapData, packedGridPos, mapId, x, y);
+        std::unique_lock<std::shared_mutex> meshGuard(mmapData->navMeshLock);
+        return loadMapInternal(fileName.get(), mmapData->navMesh, mmapData->mmapLoadedTiles, packedGridPos, mapId, x, y);
     }
 
-    bool MMapManager::loadMapInternal(const char* filePath, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y)
+    bool MMapManager::loadMapInternal(const char* filePath, dtNavMesh* navMesh, MMapTileSet& loadedTiles, uint32 packedGridPos, uint32 mapId, int32 x, int32 y)
     {
         FILE* file = fopen(filePath, "rb");
         if (!file)
@@ -276,7 +388,7 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmapData->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        dtStatus dtResult = navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
             sLog.outError("MMAP:loadMap: Could not load %s into navmesh", filePath);
@@ -284,7 +396,7 @@ namespace MMAP
             return false;
         }
 
-        mmapData->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        loadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
         ++m_loadedTiles;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap:%s: Loaded into %03i[%02i,%02i]", filePath, mapId, header->x, header->y);
         return true;
@@ -365,26 +477,10 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId)
+    bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId, bool shareTiles)
     {
-        if (!loadMapData(basePath, mapId, instanceId))
-            return false;
-
-        auto& mmap = m_loadedMMaps[packInstanceId(mapId, instanceId)];
-
-        // allocate mesh query
-        dtNavMeshQuery* query = dtAllocNavMeshQuery();
-        MANGOS_ASSERT(query);
-        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-        {
-            dtFreeNavMeshQuery(query);
-            ERROR_DB_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-        mmap->navMeshQuery = query;
-        return true;
+        // mesh queries are created by GetNavMeshQuery on first use of every thread
+        return loadMapData(basePath, mapId, instanceId, shareTiles);
     }
 
     bool MMapManager::unloadMap(uint32 mapId, uint32 instanceId, int32 x, int32 y)
@@ -400,6 +496,13 @@ namespace MMAP
 
         const auto& mmapData = (*itr).second;
 
+        // shared mesh is read only, ChangeTile detaches the instance first
+        if (mmapData->sharedMesh)
+        {
+            sLog.outError("MMAP:unloadMap: Asked to unload tile %03u%02i%02i.mmtile from shared navmesh of instance %u", mapId, x, y, instanceId);
+            return false;
+        }
+
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmapData->mmapLoadedTiles.find(packedGridPos) == mmapData->mmapLoadedTiles.end())
@@ -411,6 +514,8 @@ namespace MMAP
 
         dtTileRef tileRef = mmapData->mmapLoadedTiles[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> meshGuard(mmapData->navMeshLock);
+
         // unload, and mark as non loaded
         dtStatus dtResult = mmapData->navMesh->removeTile(tileRef, nullptr, nullptr);
         if (dtStatusFailed(dtResult))
@@ -444,9 +549,9 @@ namespace MMAP
                 continue;
             }
 
-            // unload all tiles from given map
+            // unload all tiles from given map, the shared mesh frees its own on last release
             const auto& mmapData = (*itr).second;
-            for (MMapTileSet::iterator i = mmapData->mmapLoadedTiles.begin(); i != mmapData->mmapLoadedTiles.end(); ++i)
+            for (MMapTileSet::iterator i = mmapData->mmapLoadedTiles.begin(); i != mmapData->mmapLoadedTiles.end() && !mmapData->sharedMesh; ++i)
             {
                 uint32 x = (i->first >> 16);
                 uint32 y = (i->first & 0x0000FFFF);
@@ -485,10 +590,18 @@ namespace MMAP
 
         const auto& mmapData = (*itr).second;
 
-        dtNavMeshQuery* query = mmapData->navMeshQuery;
+        // drop the reference, the shared mesh is freed with its last instance
+        if (mmapData->sharedMesh)
+        {
+            m_loadedMMaps.erase(itr);
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Released shared navmesh of mapId %03u instanceId %u", mapId, instanceId);
+            return true;
+        }
 
-        dtFreeNavMeshQuery(query);
-        mmapData->navMeshQuery = nullptr;
+        std::unique_lock<std::shared_mutex> queriesGuard(mmapData->queriesLock);
+        for (auto& navMeshQuery : mmapData->navMeshQueries)
+            dtFreeNavMeshQuery(navMeshQuery.second);
+        mmapData->navMeshQueries.clear();
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
 
         return true;
@@ -503,6 +616,20 @@ namespace MMAP
         return (*itr).second->navMesh;
     }
 
+    dtNavMesh* MMapManager::GetWritableNavMesh(std::string const& basePath, uint32 mapId, uint32 instanceId)
+    {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr == m_loadedMMaps.end())
+            return nullptr;
+
+        // changes must never reach the instances sharing the mesh
+        if (itr->second->sharedMesh)
+            if (!detachSharedMesh(basePath, mapId, instanceId, *itr->second))
+                return nullptr;
+
+        return itr->second->navMesh;
+    }
+
     dtNavMesh const* MMapManager::GetGONavMesh(uint32 mapId)
     {
         if (m_loadedModels.find(mapId) == m_loadedModels.end())
@@ -517,7 +644,48 @@ namespace MMAP
         if (itr == m_loadedMMaps.end())
             return nullptr;
 
-        return itr->second->navMeshQuery;
+        MMapData& mmapData = *itr->second;
+        auto threadId = std::this_thread::get_id();
+        {
+            std::shared_lock<std::shared_mutex> queriesGuard(mmapData.queriesLock);
+            auto queryItr = mmapData.navMeshQueries.find(threadId);
+            if (queryItr != mmapData.navMeshQueries.end())
+                return queryItr->second;
+        }
+
+        // allocate mesh query, only this thread will ever use it
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+
+        std::unique_lock<std::shared_mutex> queriesGuard(mmapData.queriesLock);
+        if (dtStatusFailed(query->init(mmapData.navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            ERROR_DB_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+        mmapData.navMeshQueries.emplace(threadId, query);
+        return query;
+    }
+
+    std::shared_lock<std::shared_mutex> MMapManager::LockNavMesh(uint32 mapId, uint32 instanceId)
+    {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr == m_loadedMMaps.end())
+            return std::shared_lock<std::shared_mutex>();
+
+        return std::shared_lock<std::shared_mutex>(itr->second->navMeshLock);
+    }
+
+    std::unique_lock<std::shared_mutex> MMapManager::LockNavMeshForWrite(uint32 mapId, uint32 instanceId)
+    {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr == m_loadedMMaps.end())
+            return std::unique_lock<std::shared_mutex>();
+
+        return std::unique_lock<std::shared_mutex>(itr->second->navMeshLock);
     }
 
     dtNavMeshQuery const* MMapManager::GetModelNavMeshQuery(uint32 displayId)
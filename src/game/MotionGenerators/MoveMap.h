@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 class Unit;
 
@@ -45,23 +46,46 @@ namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshGOQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshQuerySet;
+
+    // navmesh holding all default tiles of a map, loaded once and then only read
+    // detour writes tile links into the tile data itself, so instances share the whole mesh rather than single tiles
+    struct MMapSharedMesh
+    {
+        MMapSharedMesh(dtNavMesh* mesh) : navMesh(mesh) {}
+        ~MMapSharedMesh()
+        {
+            if (navMesh)
+                dtFreeNavMesh(navMesh);
+        }
+
+        dtNavMesh* navMesh;
+        MMapTileSet loadedTiles;
+    };
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh), navMeshQuery(nullptr), fullLoaded(false) {}
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), fullLoaded(false) {}
+        MMapData(std::shared_ptr<MMapSharedMesh> shared) : navMesh(shared->navMesh), sharedMesh(std::move(shared)),
+            mmapLoadedTiles(sharedMesh->loadedTiles), fullLoaded(true) {}
         ~MMapData()
         {
-            dtFreeNavMeshQuery(navMeshQuery);
+            for (auto& navMeshQuery : navMeshQueries)
+                dtFreeNavMeshQuery(navMeshQuery.second);
 
-            if (navMesh)
+            if (navMesh && !sharedMesh)
                 dtFreeNavMesh(navMesh);
         }
 
         dtNavMesh* navMesh;
+        std::shared_ptr<MMapSharedMesh> sharedMesh;     // set while navMesh is the map's shared mesh, must not be modified then
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        dtNavMeshQuery* navMeshQuery;       // mmap data in wotlk is already packed per instance id
+        // dtNavMeshQuery is not thread safe, every thread searching this instance gets its own
+        NavMeshQuerySet navMeshQueries;     // mmap data in wotlk is already packed per instance id
+        std::shared_mutex queriesLock;      // guards navMeshQueries
+        // searches hold it shared, adding or removing tiles exclusively
+        std::shared_mutex navMeshLock;
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
 
         bool fullLoaded;
@@ -96,20 +120,27 @@ namespace MMAP
 
             void loadAllMapTiles(std::string const& basePath, uint32 mapId, uint32 instanceId);
             bool loadMap(std::string const& basePath, uint32 mapId, uint32 instanceId, int32 x, int32 y, uint32 number);
-            bool loadMapInternal(const char* filePath, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y);
-            bool loadMapData(std::string const& basePath, uint32 mapId, uint32 instanceId);
+            bool loadMapInternal(const char* filePath, dtNavMesh* navMesh, MMapTileSet& loadedTiles, uint32 packedGridPos, uint32 mapId, int32 x, int32 y);
+            bool loadMapData(std::string const& basePath, uint32 mapId, uint32 instanceId, bool shareTiles = false);
             void loadAllGameObjectModels(std::string const& basePath, std::vector<uint32> const& displayIds);
             bool loadGameObject(std::string const& basePath, uint32 displayId);
-            bool loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId);
+            // shareTiles: use the map's shared read-only navmesh until this instance changes a tile
+            bool loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId, bool shareTiles = false);
             bool unloadMap(uint32 mapId, uint32 instanceId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
             bool IsMMapTileLoaded(uint32 mapId, uint32 instanceId, uint32 x, uint32 y) const;
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread, use it only while holding LockNavMesh
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // keeps tiles of the instance from being loaded or unloaded while its navmesh is searched
+            std::shared_lock<std::shared_mutex> LockNavMesh(uint32 mapId, uint32 instanceId);
+            // held while polygons of the navmesh returned by GetWritableNavMesh are changed
+            std::unique_lock<std::shared_mutex> LockNavMeshForWrite(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId, uint32 instanceId);
+            // detaches the instance from the shared navmesh so it may be modified, call without holding LockNavMesh
+            dtNavMesh* GetWritableNavMesh(std::string const& basePath, uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetGONavMesh(uint32 displayId);
 
             uint32 getLoadedTilesCount() const { return m_loadedTiles; }
@@ -123,8 +154,16 @@ namespace MMAP
             uint32 packTileID(int32 x, int32 y) const;
             uint64 packInstanceId(uint32 mapId, uint32 instanceId) const;
 
-            std::unordered_map<uint64, std::unique_ptr<MMapData>> m_loadedMMaps;
+            dtNavMesh* createNavMesh(std::string const& basePath, uint32 mapId);
+            void loadAllTiles(std::string const& basePath, uint32 mapId, dtNavMesh* navMesh, MMapTileSet& loadedTiles);
+            std::shared_ptr<MMapSharedMesh> getSharedMesh(std::string const& basePath, uint32 mapId);
+            bool detachSharedMesh(std::string const& basePath, uint32 mapId, uint32 instanceId, MMapData& mmapData);
+
             std::atomic<uint32> m_loadedTiles;
+            std::unordered_map<uint64, std::unique_ptr<MMapData>> m_loadedMMaps;
+
+            std::unordered_map<uint32, std::weak_ptr<MMapSharedMesh>> m_sharedMeshes;
+            std::mutex m_sharedMeshesMutex;
 
             std::unordered_map<uint32, std::unique_ptr<MMapGOData>> m_loadedModels;
             std::mutex m_modelsMutex;
@@ -416,7 +416,7 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
     WorldPacket data(opcode, recv_data.size());
     data << mover->GetPackGUID();             // write guid
     movementInfo.Write(data);                 // write data
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
@@ -448,7 +448,7 @@ void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
         data << guid.WriteAsPacked();
         data << movementInfo;
         data << newspeed; // new collision height
-        mover->SendMessageToSetExcept(data, _player);
+        mover->SendMovementMessageToSetExcept(data, _player);
 
         if (_player->IsPendingDismount())
             _player->ResolvePendingUnmount();
@@ -491,7 +491,7 @@ void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
     data << guid.WriteAsPacked();
     data << movementInfo;
     data << newspeed;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 
     // skip all forced speed changes except last and unexpected
     // in run/mounted case used one ACK and it must be skipped.m_forced_speed_changes[MOVE_RUN} store both.
@@ -607,7 +607,7 @@ void WorldSession::HandleMoveKnockBackAck(WorldPacket& recv_data)
     data << movementInfo.jump.sinAngle;
     data << movementInfo.jump.xyspeed;
     data << movementInfo.jump.zspeed;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::SendKnockBack(Unit* who, float angle, float horizontalSpeed, float verticalSpeed)
@@ -638,7 +638,7 @@ void WorldSession::SendTeleportToObservers(float x, float y, float z, float orie
     MovementInfo moveInfo = _player->m_movementInfo;
     moveInfo.ChangePosition(x, y, z, orientation);
     data << moveInfo;
-    _player->SendMessageToSetExcept(data, _player);
+    _player->SendMovementMessageToSetExcept(data, _player);
 }
 #endif
 
@@ -683,7 +683,7 @@ void WorldSession::HandleMoveFlagChangeOpcode(WorldPacket& recv_data)
     WorldPacket data(response, packed.size() + movementInfo.GetSerializedSize());
     data << packed;
     data << movementInfo;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleMoveRootAck(WorldPacket& recv_data)
@@ -726,7 +726,7 @@ void WorldSession::HandleMoveRootAck(WorldPacket& recv_data)
     WorldPacket data(opcode == CMSG_FORCE_MOVE_UNROOT_ACK ? MSG_MOVE_UNROOT : MSG_MOVE_ROOT);
     data << guid.WriteAsPacked();
     data << movementInfo;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleMoveSplineDoneOpcode(WorldPacket& recv_data)
@@ -753,7 +753,7 @@ void WorldSession::HandleMoveSplineDoneOpcode(WorldPacket& recv_data)
     WorldPacket data(_player->m_movementInfo.HasMovementFlag(MOVEFLAG_ROOT) ? MSG_MOVE_ROOT : MSG_MOVE_UNROOT, recv_data.size());
     data << mover->GetPackGUID(); // write guid
     data << movementInfo;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleSummonResponseOpcode(WorldPacket& recv_data)
@@ -885,7 +885,7 @@ void WorldSession::HandleMoveTimeSkippedOpcode(WorldPacket& recv_data)
     WorldPacket data(MSG_MOVE_TIME_SKIPPED, 16);
     data << mover->GetPackGUID();
     data << timeSkipped;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 bool WorldSession::ProcessMovementInfo(MovementInfo& movementInfo, Unit* mover, Player* plMover, WorldPacket& recv_data)
@@ -41,19 +41,13 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
     m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
     m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_polyLength(0),
     m_smoothPathPolyRefs(m_pointPathLimit), m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr),
-    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
+    m_defaultNavMeshQuery(nullptr), m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
 #ifdef ENABLE_PLAYERBOTS
     , m_defaultInstanceId(m_sourceUnit->GetInstanceId())
 #endif
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
-    if (MMAP::MMapFactory::IsPathfindingEnabled(m_sourceUnit->GetMapId(), m_sourceUnit))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
-    }
-
     createFilter();
 }
 
@@ -72,6 +66,7 @@ PathFinder::PathFinder(uint32 mapId, uint32 instanceId) :
     m_sourceUnit(nullptr), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_cachedPoints(m_pointPathLimit* VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(mapId), m_defaultInstanceId(instanceId)
 {
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    auto meshGuard = mmap->LockNavMesh(mapId, instanceId);
     m_defaultNavMeshQuery = mmap->GetNavMeshQuery(mapId, instanceId);
     createFilter();
 }
@@ -79,11 +74,14 @@ PathFinder::PathFinder(uint32 mapId, uint32 instanceId) :
 
 PathFinder::~PathFinder()
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+    // pending path requests are destroyed after their source unit may have been deleted, never touch it here
+    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo()\n");
 }
 
-void PathFinder::SetCurrentNavMesh()
+std::shared_lock<std::shared_mutex> PathFinder::SetCurrentNavMesh()
 {
+    // queries are per thread and a path may be calculated on any map update thread, so look them up every time
+    std::shared_lock<std::shared_mutex> meshGuard;
     if (m_sourceUnit && MMAP::MMapFactory::IsPathfindingEnabled(m_sourceUnit->GetMapId(), m_sourceUnit))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
@@ -91,9 +89,8 @@ void PathFinder::SetCurrentNavMesh()
             m_navMeshQuery = mmap->GetModelNavMeshQuery(transport->GetDisplayId());
         else
         {
-            if (m_defaultMapId != m_sourceUnit->GetMapId())
-                m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
-
+            meshGuard = mmap->LockNavMesh(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+            m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
             m_navMeshQuery = m_defaultNavMeshQuery;
         }
 
@@ -104,12 +101,15 @@ void PathFinder::SetCurrentNavMesh()
     else if (!m_sourceUnit && MMAP::MMapFactory::IsPathfindingEnabled(m_defaultMapId, nullptr))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+        meshGuard = mmap->LockNavMesh(m_defaultMapId, m_defaultInstanceId);
+        m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_defaultMapId, m_defaultInstanceId);
         m_navMeshQuery = m_defaultNavMeshQuery;
 
         if (m_navMeshQuery)
             m_navMesh = m_navMeshQuery->getAttachedNavMesh();
     }
 #endif
+    return meshGuard;
 }
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest/* = false*/, bool straightLine/* = false*/)
@@ -136,13 +136,16 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
 #endif
 
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("pathfinder.calculate", {
-        { "entry", std::to_string(m_sourceUnit->GetEntry()) },
-        { "guid", std::to_string(m_sourceUnit->GetGUIDLow()) },
-        { "unit_type", std::to_string(m_sourceUnit->GetGUIDHigh()) },
-        { "map_id", std::to_string(m_sourceUnit->GetMapId()) },
-        { "instance_id", std::to_string(m_sourceUnit->GetInstanceId()) }
-    }, 1000);
+    auto meas = metric::make_threshold_duration<std::chrono::microseconds>("pathfinder.calculate", 1000, [&]
+    {
+        return std::map<std::string, std::string> {
+            { "entry", std::to_string(m_sourceUnit->GetEntry()) },
+            { "guid", std::to_string(m_sourceUnit->GetGUIDLow()) },
+            { "unit_type", std::to_string(m_sourceUnit->GetGUIDHigh()) },
+            { "map_id", std::to_string(m_sourceUnit->GetMapId()) },
+            { "instance_id", std::to_string(m_sourceUnit->GetInstanceId()) }
+        };
+    });
 #endif
 
     //if (GenericTransport* transport = m_sourceUnit->GetTransport())
@@ -155,7 +158,7 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
     m_forceDestination = forceDest;
     m_straightLine = straightLine;
 
-    SetCurrentNavMesh();
+    auto meshGuard = SetCurrentNavMesh();
 
 #ifdef ENABLE_PLAYERBOTS
     if(m_sourceUnit)
@@ -190,9 +193,16 @@ void PathFinder::setArea(uint32 mapId, float x, float y, float z, uint32 area, f
 
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
 
+    // area flags are written into the mesh, so never into one shared with other instances
+    dtNavMesh* navMesh = mmap->GetWritableNavMesh(sWorld.GetDataPath(), mapId, m_defaultInstanceId);
+    if (!navMesh)
+        return;
+
+    auto meshGuard = mmap->LockNavMeshForWrite(mapId, m_defaultInstanceId);
     dtNavMeshQuery const* query = mmap->GetNavMeshQuery(mapId, m_defaultInstanceId);
-    dtNavMesh const* cnavMesh = mmap->GetNavMesh(mapId, m_defaultInstanceId);
-    dtNavMesh* navMesh = const_cast<dtNavMesh*> (cnavMesh);
+    if (!query)
+        return;
+
     dtQueryFilter m_filter;
 
     uint16 includeFlags = 0;
@@ -246,9 +256,12 @@ uint32 PathFinder::getArea(uint32 mapId, float x, float y, float z)
 
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
 
+    auto meshGuard = mmap->LockNavMesh(mapId, m_defaultInstanceId);
     dtNavMeshQuery const* query = mmap->GetNavMeshQuery(mapId, m_defaultInstanceId);
-    dtNavMesh const* cnavMesh = mmap->GetNavMesh(mapId, m_defaultInstanceId);
-    dtNavMesh* navMesh = const_cast<dtNavMesh*> (cnavMesh);
+    dtNavMesh const* navMesh = mmap->GetNavMesh(mapId, m_defaultInstanceId);
+    if (!query || !navMesh)
+        return 99;
+
     dtQueryFilter m_filter;
     dtPolyRef polyRef = INVALID_POLYREF;
 
@@ -276,9 +289,13 @@ unsigned short PathFinder::getFlags(uint32 mapId, float x, float y, float z)
 
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
 
-    dtNavMeshQuery const* query = mmap->GetNavMeshQuery(mapId, 0);
-    dtNavMesh const* cnavMesh = mmap->GetNavMesh(mapId, m_defaultInstanceId);
-    dtNavMesh* navMesh = const_cast<dtNavMesh*> (cnavMesh);
+    // query and mesh must belong to the same instance, the lock only covers that one
+    auto meshGuard = mmap->LockNavMesh(mapId, m_defaultInstanceId);
+    dtNavMeshQuery const* query = mmap->GetNavMeshQuery(mapId, m_defaultInstanceId);
+    dtNavMesh const* navMesh = mmap->GetNavMesh(mapId, m_defaultInstanceId);
+    if (!query || !navMesh)
+        return 0;
+
     dtQueryFilter m_filter;
     dtPolyRef polyRef = INVALID_POLYREF;
 
@@ -1368,7 +1385,7 @@ void PathFinder::ComputePathToRandomPoint(Vector3 const& startPoint, float maxRa
     updateFilter();
 
     // be sure navmesh are set
-    SetCurrentNavMesh();
+    auto meshGuard = SetCurrentNavMesh();
 
     float angle = rand_norm_f() * 2 * M_PI_F;
     float range = rand_norm_f() * maxRange;
@@ -1460,3 +1477,8 @@ float PathFinder::dist3DSqr(const Vector3& p1, const Vector3& p2) const
 {
     return (p1 - p2).squaredLength();
 }
+
+PathRequest::PathRequest(Unit const* owner, Calculation calculation) :
+    m_ownerGuid(owner->GetObjectGuid()), m_path(owner), m_calculation(std::move(calculation)), m_ready(false)
+{
+}
@@ -25,6 +25,11 @@
 #include <Detour/Include/DetourNavMeshQuery.h>
 
 #include "Movement/MoveSplineInitArgs.h"
+#include "Entities/ObjectGuid.h"
+
+#include <atomic>
+#include <functional>
+#include <shared_mutex>
 
 using Movement::Vector3;
 using Movement::PointsArray;
@@ -143,7 +148,8 @@ class PathFinder
         void setEndPosition(const Vector3& point) { m_actualEndPosition = point; m_endPosition = point; }
         void setActualEndPosition(const Vector3& point) { m_actualEndPosition = point; }
         void NormalizePath();
-        void SetCurrentNavMesh();
+        // the returned lock keeps the tiles of the default navmesh in place while it is searched
+        std::shared_lock<std::shared_mutex> SetCurrentNavMesh();
 
         void clear()
         {
@@ -182,4 +188,31 @@ class PathFinder
                                 float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize);
 };
 
+// path queued by Map::RequestPath, calculated after the owner's map updated all its objects
+// the requester keeps the shared pointer and reads the result once IsReady, dropping it cancels the request
+// the owner is only looked up by guid, it may be gone by the time the map processes the request
+class PathRequest
+{
+    public:
+        typedef std::function<void(PathFinder&)> Calculation;
+
+        PathRequest(Unit const* owner, Calculation calculation);
+
+        void Calculate()
+        {
+            m_calculation(m_path);
+            m_ready.store(true, std::memory_order_release);
+        }
+
+        ObjectGuid const& GetOwnerGuid() const { return m_ownerGuid; }
+        bool IsReady() const { return m_ready.load(std::memory_order_acquire); }
+        PathFinder& GetPath() { return m_path; }
+
+    private:
+        ObjectGuid m_ownerGuid;
+        PathFinder m_path;
+        Calculation m_calculation;
+        std::atomic<bool> m_ready;
+};
+
 #endif
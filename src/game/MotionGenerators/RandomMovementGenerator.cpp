@@ -21,12 +21,16 @@
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
 #include "MotionGenerators/RandomMovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
+#include "Maps/Map.h"
+#include "World/World.h"
 
 void AbstractRandomMovementGenerator::Initialize(Unit& owner)
 {
     owner.addUnitState(i_stateActive);
 
     m_pathFinder = std::make_unique<PathFinder>(&owner);
+    m_pathRequest.reset();
 
     // Client-controlled unit should have control removed
     if (const Player* controllingClientPlayer = owner.GetClientControlling())
@@ -51,6 +55,7 @@ void AbstractRandomMovementGenerator::Initialize(Unit& owner)
 void AbstractRandomMovementGenerator::Finalize(Unit& owner)
 {
     owner.clearUnitState(i_stateActive | i_stateMotion);
+    m_pathRequest.reset();
 
     // Client-controlled unit should have control restored
     if (const Player* controllingClientPlayer = owner.GetClientControlling())
@@ -71,6 +76,7 @@ void AbstractRandomMovementGenerator::Interrupt(Unit& owner)
     owner.InterruptMoving();
 
     owner.clearUnitState(i_stateMotion);
+    m_pathRequest.reset();
 }
 
 void AbstractRandomMovementGenerator::Reset(Unit& owner)
@@ -98,7 +104,12 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
 
         if (i_nextMoveTimer.Passed())
         {
-            if (_setLocation(owner))
+            int32 duration = _setLocation(owner);
+            // path is still being calculated by the map, try again on the next update
+            if (duration < 0)
+                return true;
+
+            if (duration)
             {
                 if (i_nextMoveCount > 1)
                     --i_nextMoveCount;
@@ -118,19 +129,47 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
 
 int32 AbstractRandomMovementGenerator::_setLocation(Unit& owner)
 {
-    // Look for a random location within certain radius of initial position
-    float x = i_x, y = i_y, z = i_z;
+    PathFinder* path = m_pathFinder.get();
+    std::shared_ptr<PathRequest> request = std::move(m_pathRequest);
+    if (request)
+    {
+        if (!request->IsReady())
+        {
+            m_pathRequest = std::move(request);
+            return -1;
+        }
 
-    if (i_pathLength != 0.0f)
-        m_pathFinder->setPathLengthLimit(i_pathLength);
+        path = &request->GetPath();
+    }
+    else
+    {
+        // Look for a random location within certain radius of initial position
+        Vector3 center(i_x, i_y, i_z);
+        float radius = i_radius;
+        float pathLength = i_pathLength;
+        auto calculation = [center, radius, pathLength](PathFinder& pathFinder)
+        {
+            if (pathLength != 0.0f)
+                pathFinder.setPathLengthLimit(pathLength);
+
+            pathFinder.ComputePathToRandomPoint(center, radius);
+        };
+
+        // passengers and client controlled creatures keep calculating at once
+        if (sWorld.getConfig(CONFIG_BOOL_PATH_FIND_ASYNC) && owner.IsCreature() && !owner.GetTransport() && !owner.IsClientControlled())
+        {
+            m_pathRequest = owner.GetMap()->RequestPath(&owner, std::move(calculation));
+            return -1;
+        }
 
-    m_pathFinder->ComputePathToRandomPoint(Vector3(x, y, z), i_radius);
+        calculation(*path);
+    }
 
-    if ((m_pathFinder->getPathType() & PATHFIND_NOPATH) != 0)
+    if ((path->getPathType() & PATHFIND_NOPATH) != 0)
         return 0;
 
     Movement::MoveSplineInit init(owner);
-    init.MovebyPath(m_pathFinder->getPath());
+    init.MovebyPath(path->getPath());
 
     if (i_randomRunWander)
         init.SetWalk(urand(0, 99) >= 15);
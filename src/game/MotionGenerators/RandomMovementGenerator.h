@@ -23,6 +23,7 @@
 #include "Entities/ObjectGuid.h"
 
 class PathFinder;
+class PathRequest;
 
 class AbstractRandomMovementGenerator : public MovementGenerator
 {
@@ -52,6 +53,7 @@ class AbstractRandomMovementGenerator : public MovementGenerator
         bool i_randomRunWander;
 
         std::unique_ptr<PathFinder> m_pathFinder;
+        std::shared_ptr<PathRequest> m_pathRequest;     // pending PathFinder.Async calculation
         ShortTimeTracker i_nextMoveTimer;
         uint32 i_nextMoveCount, i_nextMoveCountMax;
         uint32 i_nextMoveDelayMin, i_nextMoveDelayMax;
@@ -53,4 +53,7 @@ class WorldPacket : public ByteBuffer
         Opcodes m_opcode;
         std::chrono::steady_clock::time_point m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
+
+// smaller payloads are cheaper to copy into the socket buffer than to write as separate segment
+#define SHARED_PACKET_MIN_SIZE 256
 #endif
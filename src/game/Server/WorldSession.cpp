@@ -30,6 +30,7 @@
 #include "Server/WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Entities/Player.h"
+#include "Entities/UpdateData.h"
 #include "Globals/ObjectMgr.h"
 #include "Groups/Group.h"
 #include "Guilds/Guild.h"
@@ -62,6 +63,9 @@
 #include "playerbot/playerbot.h"
 #endif
 
+// flush aggregated moves early once this much is pending, keeps the compressed packet reasonably small
+#define MOVEMENT_BUFFER_MAX_SIZE 8192
+
 // select opcodes appropriate for processing in Map::Update context for current session state
 static bool MapSessionFilterHelper(WorldSession* session, OpcodeHandler const& opHandle)
 {
@@ -109,7 +113,8 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_sessionState(WORLD_SESSION_STATE_CREATED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0),
-    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter) {}
+    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter),
+    m_movementPacketCount(0), m_movementBufferTime(0) {}
 
 /// WorldSession destructor
 WorldSession::~WorldSession()
@@ -205,8 +210,8 @@ void WorldSession::SetExpansion(uint8 expansion)
     SendAuthOk(); // this is a hack but does what we need - resets expansion setting in client
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const& packet) const
+/// Let the bot AI of this session's player see a packet sent to it
+void WorldSession::HandleBotOutgoingPacket(WorldPacket const& packet) const
 {
 #if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
     // Send packet to bot AI
@@ -217,17 +222,15 @@ void WorldSession::SendPacket(WorldPacket const& packet) const
         else if (GetPlayer()->GetPlayerbotMgr())
             GetPlayer()->GetPlayerbotMgr()->HandleMasterOutgoingPacket(packet);
     }
+#else
+    (void)packet;
 #endif
-
-    if (!m_socket)
-    {
-        //sLog.outDebug("Refused to send %s to %s", packet.GetOpcodeName(), _player ? _player->GetName() : "UKNOWN");
-        return;
-    }
+}
 
 #ifdef MANGOS_DEBUG
-
-    // Code for network use statistic
+// Code for network use statistic
+static void LogSendStatistics(WorldPacket const& packet)
+{
     static uint64 sendPacketCount = 0;
     static uint64 sendPacketBytes = 0;
 
@@ -258,12 +261,159 @@ void WorldSession::SendPacket(WorldPacket const& packet) const
         sendLastPacketCount = 1;
         sendLastPacketBytes = packet.wpos();               // wpos is real written size
     }
-
+}
 #endif                                                  // !MANGOS_DEBUG
 
+/// Send a packet shared with other sessions to the client
+void WorldSession::SendPacket(SharedWorldPacket const& packet) const
+{
+    // queued movement was broadcast before this packet, the client has to see it first
+    if (m_movementPacketCount.load(std::memory_order_relaxed))
+        FlushMovementPackets(true);
+
+    HandleBotOutgoingPacket(*packet);
+
+    if (!m_socket)
+        return;
+
+#ifdef MANGOS_DEBUG
+    LogSendStatistics(*packet);
+#endif
+
     m_socket->SendPacket(packet);
 }
 
+void PacketBroadcast::SendTo(WorldSession* session)
+{
+    if (m_packet.size() < SHARED_PACKET_MIN_SIZE)
+    {
+        session->SendPacket(m_packet);
+        return;
+    }
+
+    if (!m_shared)
+        m_shared = std::make_shared<WorldPacket const>(m_packet);
+    session->SendPacket(m_shared);
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const& packet, bool compressInNetworkThread) const
+{
+    // queued movement was broadcast before this packet, the client has to see it first
+    if (m_movementPacketCount.load(std::memory_order_relaxed))
+        FlushMovementPackets(true);
+
+    SendPacketToSocket(packet, compressInNetworkThread);
+}
+
+/// Send a packet to the client, bypassing the queued movement
+void WorldSession::SendPacketToSocket(WorldPacket const& packet, bool compressInNetworkThread) const
+{
+    HandleBotOutgoingPacket(packet);
+
+    if (!m_socket)
+    {
+        //sLog.outDebug("Refused to send %s to %s", packet.GetOpcodeName(), _player ? _player->GetName() : "UKNOWN");
+        return;
+    }
+
+#ifdef MANGOS_DEBUG
+    LogSendStatistics(packet);
+#endif
+
+    if (compressInNetworkThread)
+        m_socket->SendUpdatePacket(packet);
+    else
+        m_socket->SendPacket(packet);
+}
+
+void WorldSession::SendMovementPacket(WorldPacket const& packet)
+{
+    uint32 delay = sWorld.getConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_DELAY);
+
+    // bots read their packets synchronously and entries carry the payload size in a single byte
+    if (!delay || !m_socket || packet.size() + sizeof(uint16) > 0xFF)
+    {
+        SendPacket(packet);
+        return;
+    }
+
+    bool flush;
+    {
+        std::lock_guard<std::mutex> guard(m_movementBufferLock);
+        if (m_movementBuffer.empty())
+            m_movementBufferTime = WorldTimer::getMSTime();
+
+        m_movementBuffer << uint8(packet.size() + sizeof(uint16));
+        m_movementBuffer << uint16(packet.GetOpcode());
+        if (!packet.empty())
+            m_movementBuffer.append(packet.contents(), packet.size());
+        ++m_movementPacketCount;
+
+        flush = m_movementBuffer.size() >= MOVEMENT_BUFFER_MAX_SIZE;
+    }
+
+    if (flush)
+        FlushMovementPackets(true);
+}
+
+void WorldSession::FlushMovementPackets(bool force) const
+{
+    ByteBuffer buffer;
+    uint32 count;
+    {
+        std::lock_guard<std::mutex> guard(m_movementBufferLock);
+        if (m_movementBuffer.empty())
+            return;
+
+        if (!force && WorldTimer::getMSTimeDiff(m_movementBufferTime, WorldTimer::getMSTime()) < sWorld.getConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_DELAY))
+            return;
+
+        std::swap(buffer, m_movementBuffer);
+        count = m_movementPacketCount;
+        m_movementPacketCount = 0;
+    }
+
+    if (count > 1)
+    {
+        uint32 destSize = compressBound(buffer.size());
+        WorldPacket data(SMSG_COMPRESSED_MOVES, 0);
+        data.resize(destSize + sizeof(uint32));
+        data.put<uint32>(0, buffer.size());
+
+        UpdateData::Compress(const_cast<uint8*>(data.contents()) + sizeof(uint32), &destSize, const_cast<uint8*>(buffer.contents()), buffer.size());
+        if (destSize)
+        {
+            data.resize(destSize + sizeof(uint32));
+            SendPacketToSocket(data, false);
+            return;
+        }
+    }
+
+    // single packet or failed compression (already logged), unpack the entries again
+    while (buffer.rpos() < buffer.size())
+    {
+        uint8 size;
+        uint16 opcode;
+        buffer >> size >> opcode;
+
+        WorldPacket data(Opcodes(opcode), size - sizeof(uint16));
+        if (size > sizeof(uint16))
+        {
+            data.append(buffer.contents() + buffer.rpos(), size - sizeof(uint16));
+            buffer.read_skip(size - sizeof(uint16));
+        }
+        SendPacketToSocket(data, false);
+    }
+}
+
+void WorldSession::ClearMovementPackets()
+{
+    std::lock_guard<std::mutex> guard(m_movementBufferLock);
+    m_movementBuffer.clear();
+    m_movementPacketCount = 0;
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
 {
@@ -633,6 +783,9 @@ void WorldSession::LogoutPlayer()
 
     m_playerLogout = true;
 
+    // moves of the world we are leaving are of no use anymore
+    ClearMovementPackets();
+
     if (_player)
     {
 #ifdef BUILD_DEPRECATED_PLAYERBOT
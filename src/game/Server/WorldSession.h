@@ -267,7 +267,14 @@ class WorldSession
 
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
-        void SendPacket(WorldPacket const& packet) const;
+        void SendPacket(WorldPacket const& packet, bool compressInNetworkThread = false) const;
+        void SendPacket(SharedWorldPacket const& packet) const;
+        /// Queues a movement broadcast of another object, sent as part of one SMSG_COMPRESSED_MOVES per flush
+        /// every other packet flushes the queue first, so only back to back movement broadcasts are combined
+        void SendMovementPacket(WorldPacket const& packet);
+        /// Sends queued movement broadcasts, unless force is set only once the aggregation delay has passed
+        void FlushMovementPackets(bool force) const;
+        void ClearMovementPackets();
         void SendExpectedSpamRecords();
         void SendMotd();
         void SendOfflineNameQueryResponses();
@@ -435,8 +442,8 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction) const;
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         static void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-                                   uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const;
+        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, uint32 listfrom, uint32 usable,
+                                   uint32& count, uint32& totalcount, bool isFull) const;
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid) const;
 
@@ -1043,6 +1050,10 @@ class WorldSession
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
+
+        // hands outgoing packets to the bot AI of this session, if any
+        void HandleBotOutgoingPacket(WorldPacket const& packet) const;
+        void SendPacketToSocket(WorldPacket const& packet, bool compressInNetworkThread) const;
         void LogUnprocessedTail(WorldPacket& packet) const;
 
         void ProcessByteBufferException(WorldPacket const& packet);
@@ -1110,9 +1121,35 @@ class WorldSession
         std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
         std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
 
+        // movement broadcasts queued by SendMovementPacket, entries are [uint8 size][uint16 opcode][payload]
+        // mutable as every SendPacket flushes them first to keep the order of the packets
+        mutable std::mutex m_movementBufferLock;
+        mutable ByteBuffer m_movementBuffer;
+        mutable std::atomic<uint32> m_movementPacketCount;
+        mutable uint32 m_movementBufferTime;
+
         Messager<WorldSession> m_messager;
 
         std::atomic<uint32> m_currentPlayerLevel;
 };
+
+/**
+ * Sends one packet to many sessions.
+ *
+ * Large packets are copied once into a shared buffer on first use, every socket then
+ * only encrypts its own header and writes the payload straight from that buffer.
+ * Small packets are cheaper to copy inline and are sent as usual.
+ */
+class PacketBroadcast
+{
+    public:
+        explicit PacketBroadcast(WorldPacket const& packet) : m_packet(packet) {}
+
+        void SendTo(WorldSession* session);
+
+    private:
+        WorldPacket const& m_packet;
+        SharedWorldPacket m_shared;
+};
 #endif
 /// @}
@@ -29,6 +29,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Auth/CryptoHash.h"
 #include "Server/WorldSession.h"
+#include "Entities/UpdateData.h"
 #include "Log/Log.h"
 #include "Server/DBCStores.h"
 #include "Util/CommonDefines.h"
@@ -37,6 +38,7 @@
 #include "LuaEngine/LuaEngine.h"
 #endif
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -109,6 +111,10 @@ std::vector<uint32> InitOpcodeCooldowns()
 
 std::vector<uint32> WorldSocket::m_packetCooldowns = InitOpcodeCooldowns();
 
+static std::atomic<uint64> s_writeFlushes(0);
+static std::atomic<uint64> s_writePackets(0);
+static std::atomic<uint64> s_writeBytes(0);
+
 std::deque<uint32> WorldSocket::GetOutOpcodeHistory()
 {
     std::lock_guard<std::mutex> guard(m_worldSocketMutex);
@@ -122,7 +128,7 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_context& context) : AsyncSocket(context), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0),
-    m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_session(nullptr), m_seed(urand()), m_outPackets(0), m_writeInProgress(false), m_deferredInProgress(false), m_loggingPackets(false)
 {
 }
 
@@ -131,17 +137,80 @@ void WorldSocket::SendPacket(const WorldPacket& pct)
     if (IsClosed())
         return;
 
+    // encrypt thread unsafe due to being executed from map contexts frequently
+    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+
+    // keep order behind update packets still waiting for compression
+    if (m_deferredInProgress || !m_deferredPackets.empty())
+        m_deferredPackets.push_back({ std::make_unique<WorldPacket>(pct), nullptr, false });
+    else
+        AppendPacket(pct);
+
+    ScheduleFlush();
+}
+
+void WorldSocket::SendPacket(const SharedWorldPacket& pct)
+{
+    if (IsClosed())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+
+    if (m_deferredInProgress || !m_deferredPackets.empty())
+        m_deferredPackets.push_back({ nullptr, pct, false });
+    else
+        AppendPacket(pct);
+
+    ScheduleFlush();
+}
+
+void WorldSocket::SendUpdatePacket(const WorldPacket& pct)
+{
+    if (IsClosed())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+    m_deferredPackets.push_back({ std::make_unique<WorldPacket>(pct), nullptr, true });
+    ScheduleFlush();
+}
+
+void WorldSocket::AppendPacket(const WorldPacket& pct)
+{
+    AppendHeader(pct);
+
+    if (pct.size() > 0)
+    {
+        size_t offset = m_outBuffer.size();
+        m_outBuffer.resize(offset + pct.size());
+        std::memcpy(m_outBuffer.data() + offset, pct.contents(), pct.size());
+    }
+    ++m_outPackets;
+}
+
+void WorldSocket::AppendPacket(const SharedWorldPacket& pct)
+{
+    if (pct->size() < SHARED_PACKET_MIN_SIZE)
+    {
+        AppendPacket(*pct);
+        return;
+    }
+
+    AppendHeader(*pct);
+
+    // only the header is per socket, the payload is gathered from the shared packet on write
+    m_outShared.push_back({ m_outBuffer.size(), pct });
+    ++m_outPackets;
+}
+
+void WorldSocket::AppendHeader(const WorldPacket& pct)
+{
     if (sPacketLog->CanLogPacket() && IsLoggingPackets())
         sPacketLog->LogPacket(pct, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
     // Dump outgoing packet.
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct.GetOpcode(), pct.GetOpcodeName(), pct, false);
 
-    // encrypt thread unsafe due to being executed from map contexts frequently - TODO: move to post service context in future
-    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
-
     ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
-    m_crypt.EncryptSend(static_cast<uint8*>(header.header), header.headerSize());
 
     uint32 opcode = pct.GetOpcode();
 
@@ -149,21 +218,136 @@ void WorldSocket::SendPacket(const WorldPacket& pct)
     if (m_opcodeHistoryOut.size() > 50)
         m_opcodeHistoryOut.resize(30);
 
-    if (pct.size() > 0)
+    // append to pending output and encrypt header in place, the whole batch goes out in one write
+    size_t offset = m_outBuffer.size();
+    m_outBuffer.resize(offset + header.headerSize());
+    std::memcpy(m_outBuffer.data() + offset, header.data(), header.headerSize());
+    m_crypt.EncryptSend(m_outBuffer.data() + offset, header.headerSize());
+}
+
+void WorldSocket::ScheduleFlush()
+{
+    if (m_writeInProgress)
+        return;
+
+    // flush once per network loop pass, everything queued until then is coalesced
+    m_writeInProgress = true;
+    auto self(shared_from_this());
+    Post([self]() { self->FlushOutput(); });
+}
+
+void WorldSocket::ProcessDeferredPackets()
+{
+    std::vector<DeferredPacket> packets;
+    while (true)
     {
-        // allocate array for full message
-        std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(header.headerSize() + pct.size());
-        std::memcpy(fullMessage->data(), header.data(), header.headerSize()); // copy header
-        std::memcpy((fullMessage->data() + header.headerSize()), reinterpret_cast<const char*>(pct.contents()), pct.size()); // copy packet
-        auto self(shared_from_this());
-        Write(fullMessage->data(), fullMessage->size(), [self, fullMessage](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+        {
+            std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+            for (DeferredPacket const& deferred : packets)
+            {
+                if (deferred.shared)
+                    AppendPacket(deferred.shared);
+                else
+                    AppendPacket(*deferred.packet);
+            }
+            packets.clear();
+
+            if (m_deferredPackets.empty())
+            {
+                m_deferredInProgress = false;
+                return;
+            }
+
+            // senders keep queueing behind us until the batch taken here is appended
+            std::swap(packets, m_deferredPackets);
+            m_deferredInProgress = true;
+        }
+
+        for (DeferredPacket& deferred : packets)
+            if (deferred.compress)
+                UpdateData::CompressPacket(*deferred.packet);
     }
-    else
+}
+
+void WorldSocket::FlushOutput()
+{
+    uint32 packets;
+    while (true)
+    {
+        ProcessDeferredPackets();
+
+        std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+        if (IsClosed())
+        {
+            m_writeInProgress = false;
+            return;
+        }
+
+        if (m_outBuffer.empty())
+        {
+            // update packets queued after the deferred batch was drained did not post a flush of their own
+            if (!m_deferredPackets.empty())
+                continue;
+
+            m_writeInProgress = false;
+            return;
+        }
+
+        m_sendBuffer.clear();
+        std::swap(m_sendBuffer, m_outBuffer);
+        m_sendShared.clear();
+        std::swap(m_sendShared, m_outShared);
+        packets = m_outPackets;
+        m_outPackets = 0;
+        break;
+    }
+
+    auto onWritten = [self = shared_from_this()](const boost::system::error_code& error, std::size_t written)
+    {
+        s_writeBytes.fetch_add(written, std::memory_order_relaxed);
+        if (error)
+        {
+            std::lock_guard<std::mutex> guard(self->m_worldSocketMutex);
+            self->m_writeInProgress = false;
+            return;
+        }
+
+        // packets queued while this write was in flight
+        self->FlushOutput();
+    };
+
+    s_writeFlushes.fetch_add(1, std::memory_order_relaxed);
+    s_writePackets.fetch_add(packets, std::memory_order_relaxed);
+
+    if (m_sendShared.empty())
+    {
+        Write(reinterpret_cast<const char*>(m_sendBuffer.data()), m_sendBuffer.size(), std::move(onWritten));
+        return;
+    }
+
+    // interleave the header runs of the send buffer with the shared payloads
+    m_sendSegments.clear();
+    size_t position = 0;
+    for (SharedPayload const& payload : m_sendShared)
     {
-        std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>(header);
-        auto self(shared_from_this());
-        Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+        if (payload.offset > position)
+            m_sendSegments.emplace_back(m_sendBuffer.data() + position, payload.offset - position);
+        m_sendSegments.emplace_back(payload.packet->contents(), payload.packet->size());
+        position = payload.offset;
     }
+    if (position < m_sendBuffer.size())
+        m_sendSegments.emplace_back(m_sendBuffer.data() + position, m_sendBuffer.size() - position);
+
+    Write(m_sendSegments, std::move(onWritten));
+}
+
+WorldSocket::WriteStats WorldSocket::ConsumeWriteStats()
+{
+    WriteStats stats;
+    stats.flushes = s_writeFlushes.exchange(0, std::memory_order_relaxed);
+    stats.packets = s_writePackets.exchange(0, std::memory_order_relaxed);
+    stats.bytes = s_writeBytes.exchange(0, std::memory_order_relaxed);
+    return stats;
 }
 
 bool WorldSocket::OnOpen()
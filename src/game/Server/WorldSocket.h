@@ -33,10 +33,15 @@
 #include <chrono>
 #include <functional>
 #include <deque>
+#include <memory>
+#include <vector>
 
 class WorldPacket;
 class WorldSession;
 
+// immutable packet handed to many sockets, each one writes the payload straight from it
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 /**
  * WorldSocket.
  *
@@ -118,8 +123,54 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
         /// Called by ProcessIncoming() on CMSG_PING.
         bool HandlePing(WorldPacket& recvPacket);
 
+        struct DeferredPacket
+        {
+            std::unique_ptr<WorldPacket> packet;
+            SharedWorldPacket shared;
+            bool compress;
+        };
+
+        /// Payload written from a shared packet, placed at offset of the output buffer
+        struct SharedPayload
+        {
+            size_t offset;
+            SharedWorldPacket packet;
+        };
+
+        /// Logs, encrypts and queues one packet for the next flush, m_worldSocketMutex must be held
+        void AppendPacket(const WorldPacket& pct);
+        /// Queues only the encrypted header, the payload is written from the shared packet, m_worldSocketMutex must be held
+        void AppendPacket(const SharedWorldPacket& pct);
+        /// Logs the packet and appends its encrypted header, m_worldSocketMutex must be held
+        void AppendHeader(const WorldPacket& pct);
+
+        /// Posts FlushOutput to the socket's service unless a write is already pending, m_worldSocketMutex must be held
+        void ScheduleFlush();
+
+        /// Compresses deferred update packets and queues them in order, must be called from service context
+        void ProcessDeferredPackets();
+
+        /// Starts an async write of everything queued in m_outBuffer, must be called from service context
+        void FlushOutput();
+
         std::mutex m_worldSocketMutex;
 
+        /// Packets queued since the last flush, headers already encrypted
+        std::vector<uint8> m_outBuffer;
+        /// Buffer currently handed to the socket, swapped with m_outBuffer on flush
+        std::vector<uint8> m_sendBuffer;
+        /// Shared payloads between the headers of m_outBuffer and m_sendBuffer, ordered by offset
+        std::vector<SharedPayload> m_outShared;
+        std::vector<SharedPayload> m_sendShared;
+        std::vector<boost::asio::const_buffer> m_sendSegments;
+        uint32 m_outPackets;
+        /// True while a flush is posted or a write is in flight
+        bool m_writeInProgress;
+
+        /// Packets that wait for compression in service context and everything sent after them
+        std::vector<DeferredPacket> m_deferredPackets;
+        bool m_deferredInProgress;
+
         std::deque<uint32> m_opcodeHistoryOut;
         std::deque<uint32> m_opcodeHistoryInc;
 
@@ -130,6 +181,11 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct);
+        /// send a packet shared with other sockets without copying its payload
+        void SendPacket(const SharedWorldPacket& pct);
+
+        /// send an SMSG_UPDATE_OBJECT, compression is done in service context
+        void SendUpdatePacket(const WorldPacket& pct);
 
         void FinalizeSession() { m_session = nullptr; }
 
@@ -144,6 +200,16 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
         static std::vector<uint32> m_packetCooldowns;
         std::map<uint32, TimePoint> m_lastPacket;
 
+        struct WriteStats
+        {
+            uint64 flushes;
+            uint64 packets;
+            uint64 bytes;
+        };
+
+        /// Returns totals over all sockets since the last call and resets them
+        static WriteStats ConsumeWriteStats();
+
         bool IsLoggingPackets() const { return m_loggingPackets; }
         void SetPacketLogging(bool state) { m_loggingPackets = state; }
 };
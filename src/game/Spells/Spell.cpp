@@ -832,9 +832,10 @@ bool Spell::FillUnitTargets(TempTargetingData& targetingData, SpellTargetingData
         SpellTargetImplicitType type = SpellTargetInfoTable[target].type;
         if (!unitTargetList.empty()) // Unit case
         {
+            bool losChecked = CheckTargetsLineOfSight(unitTargetList, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet));
             for (auto itr = unitTargetList.begin(); itr != unitTargetList.end();)
             {
-                if (!CheckTarget(*itr, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet)))
+                if (!CheckTarget(*itr, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet), losChecked))
                     itr = unitTargetList.erase(itr);
                 else
                     ++itr;
@@ -8333,6 +8334,71 @@ void Spell::UpdatePointers()
     m_targets.Update(m_trueCaster);
 }
 
+// removes area targets out of sight of the spell's source or destination, the static models are tested for all of them in one batch
+// returns false when CheckTarget has to check line of sight itself
+bool Spell::CheckTargetsLineOfSight(UnitList& targets, SpellEffectIndex eff, bool targetB, CheckException exception) const
+{
+    if (targets.size() < 2 || exception == EXCEPTION_MAGNET || IsIgnoreLosSpellEffect(m_spellInfo, eff, targetB))
+        return false;
+
+    // same exceptions as in CheckTarget
+    switch (m_spellInfo->Effect[eff])
+    {
+        case SPELL_EFFECT_SUMMON_PLAYER:
+        case SPELL_EFFECT_RESURRECT_NEW:
+            return false;
+        default:
+            break;
+    }
+
+    SpellTargetInfo const& info = SpellTargetInfoTable[targetB ? m_spellInfo->EffectImplicitTargetB[eff] : m_spellInfo->EffectImplicitTargetA[eff]];
+    if (info.type == TARGET_TYPE_UNIT && info.filter == TARGET_SCRIPT)
+        return false;
+
+    float x, y, z;
+    switch (info.los)
+    {
+        case TARGET_LOS_DEST: m_targets.getDestination(x, y, z); break;
+        case TARGET_LOS_SRC: m_targets.getSource(x, y, z); break;
+        default: return false;
+    }
+
+    // dynamic objects are phased, targets in another phase than the first are checked one by one
+    uint32 phaseMask = targets.front()->GetPhaseMask();
+    std::vector<VMAP::LineOfSightQuery> queries;
+    queries.reserve(targets.size());
+    for (Unit* target : targets)
+    {
+        if (target->GetPhaseMask() != phaseMask)
+            continue;
+
+        float height = target->GetCollisionHeight();
+        VMAP::LineOfSightQuery query;
+        target->GetPosition(query.x1, query.y1, query.z1);
+        query.z1 += height;
+        query.x2 = x;
+        query.y2 = y;
+        query.z2 = z + height;
+        queries.push_back(query);
+    }
+
+    std::unique_ptr<bool[]> results(new bool[queries.size()]);
+    m_trueCaster->GetMap()->IsInLineOfSight(queries.data(), results.get(), queries.size(), phaseMask, true);
+
+    uint32 index = 0;
+    for (auto itr = targets.begin(); itr != targets.end();)
+    {
+        Unit* target = *itr;
+        bool inSight = target->GetPhaseMask() == phaseMask ? results[index++] : target->IsWithinLOS(x, y, z + target->GetCollisionHeight(), true);
+        if (inSight)
+            ++itr;
+        else
+            itr = targets.erase(itr);
+    }
+
+    return true;
+}
+
 bool Spell::CheckTargetCreatureType(Unit* target, SpellEntry const* spellInfo)
 {
     uint32 spellCreatureTargetMask = spellInfo->TargetCreatureType;
@@ -8361,7 +8427,7 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return (CURRENT_GENERIC_SPELL);
 }
 
-bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception) const
+bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception, bool losChecked) const
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
     if (exception != EXCEPTION_MAGNET && m_spellInfo->EffectImplicitTargetA[eff] != TARGET_UNIT_CASTER)
@@ -8441,7 +8507,7 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckE
                 // all ok by some way or another, skip normal check
                 break;
             default:                                            // normal case
-                if (exception != EXCEPTION_MAGNET && !IsIgnoreLosSpellEffect(m_spellInfo, eff, targetB))
+                if (!losChecked && exception != EXCEPTION_MAGNET && !IsIgnoreLosSpellEffect(m_spellInfo, eff, targetB))
                 {
                     float x, y, z;
                     switch (info.los)
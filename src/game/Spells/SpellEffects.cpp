@@ -5932,10 +5932,15 @@ void Spell::EffectSummonType(SpellEffectIndex eff_idx)
                 }
                 else
                 {
+                    // collected first, entering combat may change the threat list of the caster
+                    std::vector<Unit*> victims;
                     for (auto ref : m_caster->getThreatManager().getThreatList())
                         if (Unit* victim = ref->getTarget())
                             if (creature->CanAttack(victim))
-                                creature->AddThreat(victim);
+                                victims.push_back(victim);
+
+                    for (Unit* victim : victims)
+                        creature->AddThreat(victim);
                 }
 
                 if (!creature->getThreatManager().isThreatListEmpty())
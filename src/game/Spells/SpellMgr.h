@@ -2510,6 +2510,15 @@ class SpellMgr
             return nullptr;
         }
 
+        // custom spell_proc_event flags if set, else the spell's own
+        uint32 GetSpellProcFlags(SpellEntry const* spellInfo) const
+        {
+            SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+            if (spellProcEvent && spellProcEvent->procFlags)
+                return spellProcEvent->procFlags;
+            return spellInfo->procFlags;
+        }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
@@ -537,17 +537,24 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
     ProcExecutionData execData(argData, isVictim);
 
+    // holders whose proc flags do not intersect the event can never pass IsTriggeredAtSpellProcEvent
+    if (!(m_procAuraFlags & execData.procFlags))
+        return;
+
     ProcTriggeredVector procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (size_t i = 0; i < m_procAuraHolders.size(); ++i)
     {
-        SpellAuraHolder* holder = itr->second;
+        if (!(m_procAuraHolders[i].procFlags & execData.procFlags))
+            continue;
+
+        SpellAuraHolder* holder = m_procAuraHolders[i].holder;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
-        ProcTriggeredData procTriggeredData(nullptr, itr->second);
+        ProcTriggeredData procTriggeredData(nullptr, holder);
 
         SpellProcEventTriggerCheck result = IsTriggeredAtSpellProcEvent(execData, holder, procTriggeredData.spellProcEvent, procTriggeredData.canProc);
         if (holder->GetSpellProto()->HasAttribute(SPELL_ATTR_PROC_FAILURE_BURNS_CHARGE) &&
@@ -648,11 +655,7 @@ Unit::SpellProcEventTriggerCheck Unit::IsTriggeredAtSpellProcEvent(ProcExecution
     spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
 
     // Get EventProcFlag
-    uint32 EventProcFlag;
-    if (spellProcEvent && spellProcEvent->procFlags) // if exist get custom spellProcEvent->procFlags
-        EventProcFlag = spellProcEvent->procFlags;
-    else
-        EventProcFlag = spellProto->procFlags;       // else get from spell proto
+    uint32 EventProcFlag = sSpellMgr.GetSpellProcFlags(spellProto);
     // Continue if no trigger exist
     if (!EventProcFlag)
         return SpellProcEventTriggerCheck::SPELL_PROC_TRIGGER_FAILED;
@@ -28,7 +28,13 @@
 #include <vector>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BIH_PACKET_SSE
+#include <emmintrin.h>
+#endif
+
 #define MAX_STACK_SIZE 64
+#define RAY_PACKET_SIZE 4
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -118,14 +124,11 @@ class BIH
         }
         size_t primCount() const { return objects.size(); }
 
-        template<typename RayCallback>
-        void intersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst = false, bool ignoreM2Model = false) const
+        // clips the ray to the tree bounds, false if it misses them within maxDist
+        bool clipRay(const Vector3& org, const Vector3& dir, Vector3& invDir, float maxDist, float& intervalMin, float& intervalMax) const
         {
-            float intervalMin = -1.f;
-            float intervalMax = -1.f;
-            Vector3 org = r.origin();
-            Vector3 dir = r.direction();
-            Vector3 invDir;
+            intervalMin = -1.f;
+            intervalMax = -1.f;
             for (int i = 0; i < 3; ++i)
             {
                 invDir[i] = 1.f / dir[i];
@@ -142,14 +145,27 @@ class BIH
                     // intervalMax can only become smaller for other axis,
                     //  and intervalMin only larger respectively, so stop early
                     if (intervalMax <= 0 || intervalMin >= maxDist)
-                        return;
+                        return false;
                 }
             }
 
             if (intervalMin > intervalMax)
-                return;
+                return false;
             intervalMin = std::max(intervalMin, 0.f);
             intervalMax = std::min(intervalMax, maxDist);
+            return true;
+        }
+
+        template<typename RayCallback>
+        void intersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst = false, bool ignoreM2Model = false) const
+        {
+            float intervalMin;
+            float intervalMax;
+            Vector3 org = r.origin();
+            Vector3 dir = r.direction();
+            Vector3 invDir;
+            if (!clipRay(org, dir, invDir, maxDist, intervalMin, intervalMax))
+                return;
 
             uint32 offsetFront[3];
             uint32 offsetBack[3];
@@ -259,6 +275,187 @@ class BIH
             }
         }
 
+        /** Traverses up to RAY_PACKET_SIZE rays at once, node planes are tested for all of them in one go.
+            The direction of all rays in activeMask must have the same sign on every axis.
+            intersectCallback(lane, ray, entry, maxDist, stopAtFirst, ignoreM2Model) is called per ray and object.
+        */
+        template<typename PacketCallback>
+        void intersectRayPacket(const Ray (&rays)[RAY_PACKET_SIZE], PacketCallback& intersectCallback, float (&maxDist)[RAY_PACKET_SIZE], int activeMask, bool stopAtFirst = false, bool ignoreM2Model = false) const
+        {
+#ifdef BIH_PACKET_SSE
+            alignas(16) float org[3][RAY_PACKET_SIZE];
+            alignas(16) float invDir[3][RAY_PACKET_SIZE];
+            alignas(16) float intervalMin[RAY_PACKET_SIZE];
+            alignas(16) float intervalMax[RAY_PACKET_SIZE];
+            int leadRay = -1;
+            for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                Vector3 laneInvDir;
+                intervalMin[lane] = 1.f;
+                intervalMax[lane] = 0.f;
+                if ((activeMask & (1 << lane)) && !clipRay(rays[lane].origin(), rays[lane].direction(), laneInvDir, maxDist[lane], intervalMin[lane], intervalMax[lane]))
+                    activeMask &= ~(1 << lane);
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    org[i][lane] = rays[lane].origin()[i];
+                    invDir[i][lane] = 1.f / rays[lane].direction()[i];
+                }
+
+                if (leadRay < 0 && (activeMask & (1 << lane)))
+                    leadRay = lane;
+            }
+
+            if (!activeMask)
+                return;
+
+            uint32 offsetFront[3];
+            uint32 offsetBack[3];
+            uint32 offsetFront3[3];
+            uint32 offsetBack3[3];
+            // all rays share the direction signs of the first active one
+            for (int i = 0; i < 3; ++i)
+            {
+                offsetFront[i] = floatToRawIntBits(rays[leadRay].direction()[i]) >> 31;
+                offsetBack[i] = offsetFront[i] ^ 1;
+                offsetFront3[i] = offsetFront[i] * 3;
+                offsetBack3[i] = offsetBack[i] * 3;
+
+                ++offsetFront[i];
+                ++offsetBack[i];
+            }
+
+            __m128 packetOrg[3] = { _mm_load_ps(org[0]), _mm_load_ps(org[1]), _mm_load_ps(org[2]) };
+            __m128 packetInvDir[3] = { _mm_load_ps(invDir[0]), _mm_load_ps(invDir[1]), _mm_load_ps(invDir[2]) };
+            __m128 packetMin = _mm_load_ps(intervalMin);
+            __m128 packetMax = _mm_load_ps(intervalMax);
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+            int mask = activeMask;
+            int doneMask = 0;
+
+            while (true)
+            {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    const bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, same decisions as intersectRay for every ray
+                            __m128 tf = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + offsetFront[axis]])), packetOrg[axis]), packetInvDir[axis]);
+                            __m128 tb = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + offsetBack[axis]])), packetOrg[axis]), packetInvDir[axis]);
+                            int frontMask = mask & ~_mm_movemask_ps(_mm_cmplt_ps(tf, packetMin));
+                            int backMask = mask & ~_mm_movemask_ps(_mm_cmpgt_ps(tb, packetMax));
+                            int back = offset + offsetBack3[axis];
+                            int front = offset + offsetFront3[axis];
+                            // all rays pass between clip zones
+                            if (!frontMask && !backMask)
+                                break;
+                            // all rays pass through far node only
+                            if (!frontMask)
+                            {
+                                packetMin = _mm_max_ps(tb, packetMin);
+                                node = back;
+                                mask = backMask;
+                                continue;
+                            }
+                            // all rays pass through near node only
+                            if (!backMask)
+                            {
+                                packetMax = _mm_min_ps(tf, packetMax);
+                                node = front;
+                                mask = frontMask;
+                                continue;
+                            }
+                            // push back node for the rays that reach it
+                            stack[stackPos].node = back;
+                            stack[stackPos].mask = backMask;
+                            stack[stackPos].tnear = _mm_max_ps(tb, packetMin);
+                            stack[stackPos].tfar = packetMax;
+                            ++stackPos;
+                            packetMax = _mm_min_ps(tf, packetMax);
+                            node = front;
+                            mask = frontMask;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0 && mask)
+                            {
+                                for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+                                {
+                                    if (!(mask & (1 << lane)))
+                                        continue;
+
+                                    bool hit = intersectCallback(uint32(lane), rays[lane], objects[offset], maxDist[lane], stopAtFirst, ignoreM2Model);
+                                    if (stopAtFirst && hit)
+                                    {
+                                        doneMask |= 1 << lane;
+                                        mask &= ~(1 << lane);
+                                    }
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            if (doneMask == activeMask)
+                                return;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis > 2)
+                            return; // should not happen
+                        __m128 tf = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + offsetFront[axis]])), packetOrg[axis]), packetInvDir[axis]);
+                        __m128 tb = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(tree[node + offsetBack[axis]])), packetOrg[axis]), packetInvDir[axis]);
+                        node = offset;
+                        packetMin = _mm_max_ps(tf, packetMin);
+                        packetMax = _mm_min_ps(tb, packetMax);
+                        mask &= ~_mm_movemask_ps(_mm_cmpgt_ps(packetMin, packetMax));
+                        if (!mask)
+                            break;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, without the rays that finished or already hit something closer
+                    --stackPos;
+                    alignas(16) float distances[RAY_PACKET_SIZE] = { maxDist[0], maxDist[1], maxDist[2], maxDist[3] };
+                    mask = stack[stackPos].mask & ~doneMask & ~_mm_movemask_ps(_mm_cmplt_ps(_mm_load_ps(distances), stack[stackPos].tnear));
+                    if (!mask)
+                        continue;
+                    node = stack[stackPos].node;
+                    packetMin = stack[stackPos].tnear;
+                    packetMax = stack[stackPos].tfar;
+                    break;
+                } while (true);
+            }
+#else
+            for (int lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                if (!(activeMask & (1 << lane)))
+                    continue;
+
+                auto laneCallback = [&](const Ray& r, uint32 entry, float& distance, bool pStopAtFirst, bool pIgnoreM2Model)
+                {
+                    return intersectCallback(uint32(lane), r, entry, distance, pStopAtFirst, pIgnoreM2Model);
+                };
+                intersectRay(rays[lane], laneCallback, maxDist[lane], stopAtFirst, ignoreM2Model);
+            }
+#endif
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3& p, IsectCallback& intersectCallback) const
         {
@@ -360,6 +557,15 @@ class BIH
             float tnear;
             float tfar;
         };
+#ifdef BIH_PACKET_SSE
+        struct PacketStackNode
+        {
+            __m128 tnear;
+            __m128 tfar;
+            uint32 node;
+            int mask;
+        };
+#endif
 
         class BuildStats
         {
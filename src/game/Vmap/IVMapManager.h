@@ -41,6 +41,18 @@ namespace VMAP
 #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
 #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
+    struct LineOfSightQuery
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+    };
+
+    struct HeightQuery
+    {
+        float x, y, z;
+        float maxSearchDist;
+    };
+
     //===========================================================
     class IVMapManager
     {
@@ -65,6 +77,19 @@ namespace VMAP
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
+            batched versions of the above for many queries on the same map, result i belongs to query i
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, LineOfSightQuery const* pQueries, bool* pResults, uint32 count, bool ignoreM2Model)
+            {
+                for (uint32 i = 0; i < count; ++i)
+                    pResults[i] = isInLineOfSight(pMapId, pQueries[i].x1, pQueries[i].y1, pQueries[i].z1, pQueries[i].x2, pQueries[i].y2, pQueries[i].z2, ignoreM2Model);
+            }
+            virtual void getHeight(unsigned int pMapId, HeightQuery const* pQueries, float* pResults, uint32 count)
+            {
+                for (uint32 i = 0; i < count; ++i)
+                    pResults[i] = getHeight(pMapId, pQueries[i].x, pQueries[i].y, pQueries[i].z, pQueries[i].maxSearchDist);
+            }
+            /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
             return a position, that is pReduceDist closer to the origin
             */
@@ -26,6 +26,8 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <vector>
 
 using G3D::Vector3;
 
@@ -48,6 +50,23 @@ namespace VMAP
             ModelInstance* prims;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val): hitMask(0), prims(val) {}
+            bool operator()(uint32 lane, G3D::Ray const& ray, uint32 entry, float& distance, bool pStopAtFirstHit, bool ignoreM2Model)
+            {
+                bool result = prims[entry].intersectRay(ray, distance, pStopAtFirstHit, ignoreM2Model);
+                if (result)
+                    hitMask |= 1 << lane;
+                return result;
+            }
+            int hitMask;
+
+        protected:
+            ModelInstance* prims;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -151,6 +170,85 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::getIntersectionTimes(G3D::Ray const* pRays, float* pMaxDist, bool* pHit, uint32 count, bool pStopAtFirstHit, bool ignoreM2Model) const
+    {
+        // a packet needs the same direction signs on all axes, bucket the rays by their octant
+        std::vector<uint32> order(count);
+        uint32 octantStart[9] = {};
+        auto octantOf = [](G3D::Ray const& ray)
+        {
+            return (floatToRawIntBits(ray.direction().x) >> 31) | ((floatToRawIntBits(ray.direction().y) >> 31) << 1) | ((floatToRawIntBits(ray.direction().z) >> 31) << 2);
+        };
+        for (uint32 i = 0; i < count; ++i)
+            ++octantStart[octantOf(pRays[i]) + 1];
+        for (uint32 octant = 1; octant < 9; ++octant)
+            octantStart[octant] += octantStart[octant - 1];
+        uint32 octantFill[8];
+        std::copy(octantStart, octantStart + 8, octantFill);
+        for (uint32 i = 0; i < count; ++i)
+            order[octantFill[octantOf(pRays[i])]++] = i;
+
+        for (uint32 octant = 0; octant < 8; ++octant)
+        {
+            for (uint32 first = octantStart[octant]; first < octantStart[octant + 1]; first += RAY_PACKET_SIZE)
+            {
+                G3D::Ray rays[RAY_PACKET_SIZE];
+                float distances[RAY_PACKET_SIZE] = {};
+                int activeMask = 0;
+                for (uint32 lane = 0; lane < RAY_PACKET_SIZE && first + lane < octantStart[octant + 1]; ++lane)
+                {
+                    uint32 index = order[first + lane];
+                    rays[lane] = pRays[index];
+                    distances[lane] = pMaxDist[index];
+                    activeMask |= 1 << lane;
+                }
+
+                MapRayPacketCallback intersectionCallBack(iTreeValues);
+                iTree.intersectRayPacket(rays, intersectionCallBack, distances, activeMask, pStopAtFirstHit, ignoreM2Model);
+
+                for (uint32 lane = 0; lane < RAY_PACKET_SIZE && first + lane < octantStart[octant + 1]; ++lane)
+                {
+                    uint32 index = order[first + lane];
+                    pHit[index] = (intersectionCallBack.hitMask & (1 << lane)) != 0;
+                    if (pHit[index])
+                        pMaxDist[index] = distances[lane];
+                }
+            }
+        }
+    }
+
+    //=========================================================
+
+    void StaticMapTree::isInLineOfSight(Vector3 const* pPos1, Vector3 const* pPos2, bool* pResults, uint32 count, bool ignoreM2Model) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> distances;
+        std::vector<uint32> indices;
+        rays.reserve(count);
+        distances.reserve(count);
+        indices.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            pResults[i] = true;
+            float maxDist = (pPos2[i] - pPos1[i]).magnitude();
+            MANGOS_ASSERT(maxDist < std::numeric_limits<float>::max());
+            // same points and NaN protection as the single ray version
+            if (maxDist < 1e-10f)
+                continue;
+
+            rays.push_back(G3D::Ray::fromOriginAndDirection(pPos1[i], (pPos2[i] - pPos1[i]) / maxDist));
+            distances.push_back(maxDist);
+            indices.push_back(i);
+        }
+
+        std::unique_ptr<bool[]> hits(new bool[rays.size()]);
+        getIntersectionTimes(rays.data(), distances.data(), hits.get(), uint32(rays.size()), true, ignoreM2Model);
+        for (size_t i = 0; i < rays.size(); ++i)
+            pResults[indices[i]] = !hits[i];
+    }
+
+    //=========================================================
+
     bool StaticMapTree::isInLineOfSight(const Vector3& pos1, const Vector3& pos2, bool ignoreM2Model) const
     {
         float maxDist = (pos2 - pos1).magnitude();
@@ -226,6 +324,30 @@ namespace VMAP
         return height;
     }
 
+    void StaticMapTree::getHeight(Vector3 const* pPos, float const* pMaxSearchDist, float* pResults, uint32 count) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> distances(count);
+        rays.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            rays.emplace_back(pPos[i], pMaxSearchDist[i] >= 0.f ? Vector3(0, 0, -1) : Vector3(0, 0, 1));
+            distances[i] = std::abs(pMaxSearchDist[i]);
+        }
+
+        std::unique_ptr<bool[]> hits(new bool[count]);
+        getIntersectionTimes(rays.data(), distances.data(), hits.get(), count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!hits[i])
+                pResults[i] = G3D::inf();
+            else if (pMaxSearchDist[i] >= 0.f)
+                pResults[i] = pPos[i].z - distances[i];
+            else
+                pResults[i] = pPos[i].z + distances[i];
+        }
+    }
+
     //=========================================================
 
     bool StaticMapTree::CanLoadMap(std::string const& vmapPath, uint32 mapID, uint32 tileX, uint32 tileY)
@@ -65,6 +65,8 @@ namespace VMAP
 
         private:
             bool getIntersectionTime(const G3D::Ray& pRay, float& pMaxDist, bool pStopAtFirstHit = false, bool ignoreM2Model = false) const;
+            // rays are sorted by direction signs and traversed in packets, pHit/pMaxDist are per ray
+            void getIntersectionTimes(const G3D::Ray* pRays, float* pMaxDist, bool* pHit, uint32 count, bool pStopAtFirstHit = false, bool ignoreM2Model = false) const;
             // bool containsLoadedMapTile(uint32 pTileIdent) const { return(iLoadedMapTiles.containsKey(pTileIdent)); }
         public:
             static std::string getTileFileName(uint32 mapID, uint32 tileX, uint32 tileY);
@@ -78,6 +80,10 @@ namespace VMAP
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, bool ignoreM2Model) const;
             bool getObjectHitPos(const G3D::Vector3& pPos1, const G3D::Vector3& pPos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
+            // batched versions of the above for many queries on the same map
+            // packets only pay off for coherent rays, keep queries of one origin next to each other
+            void isInLineOfSight(const G3D::Vector3* pPos1, const G3D::Vector3* pPos2, bool* pResults, uint32 count, bool ignoreM2Model) const;
+            void getHeight(const G3D::Vector3* pPos, const float* pMaxSearchDist, float* pResults, uint32 count) const;
             bool getAreaInfo(G3D::Vector3& pos, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const;
             bool GetLocationInfo(Vector3 const& pos, LocationInfo& info) const;
 
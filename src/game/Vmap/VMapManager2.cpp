@@ -16,8 +16,10 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <algorithm>
 #include <iomanip>
 #include <string>
+#include <vector>
 #include <sstream>
 #include "VMapManager2.h"
 #include "MapTree.h"
@@ -198,6 +200,26 @@ namespace VMAP
         }
         return result;
     }
+    void VMapManager2::isInLineOfSight(unsigned int mapId, LineOfSightQuery const* queries, bool* results, uint32 count, bool ignoreM2Model)
+    {
+        std::fill(results, results + count, true);
+        if (!isLineOfSightCalcEnabled() || !count)
+            return;
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos1(count);
+        std::vector<Vector3> pos2(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            pos1[i] = convertPositionToInternalRep(queries[i].x1, queries[i].y1, queries[i].z1);
+            pos2[i] = convertPositionToInternalRep(queries[i].x2, queries[i].y2, queries[i].z2);
+        }
+
+        instanceTree->second->isInLineOfSight(pos1.data(), pos2.data(), results, count, ignoreM2Model);
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -251,6 +273,30 @@ namespace VMAP
         return height;
     }
 
+    void VMapManager2::getHeight(unsigned int mapId, HeightQuery const* queries, float* results, uint32 count)
+    {
+        std::fill(results, results + count, VMAP_INVALID_HEIGHT_VALUE);
+        if (!isHeightCalcEnabled() || !count)
+            return;
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos(count);
+        std::vector<float> maxSearchDist(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            pos[i] = convertPositionToInternalRep(queries[i].x, queries[i].y, queries[i].z);
+            maxSearchDist[i] = queries[i].maxSearchDist;
+        }
+
+        instanceTree->second->getHeight(pos.data(), maxSearchDist.data(), results, count);
+        for (uint32 i = 0; i < count; ++i)
+            if (!(results[i] < G3D::inf()))
+                results[i] = VMAP_INVALID_HEIGHT_VALUE;     // no height
+    }
+
     //=========================================================
 
     bool VMapManager2::getAreaInfo(unsigned int mapId, float x, float y, float& z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const
@@ -97,11 +97,13 @@ namespace VMAP
             void unloadMap(unsigned int pMapId) override;
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) override;
+            void isInLineOfSight(unsigned int pMapId, LineOfSightQuery const* pQueries, bool* pResults, uint32 count, bool ignoreM2Model) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
             bool getObjectHitPos(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float pModifyDist) override;
             float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) override;
+            void getHeight(unsigned int pMapId, HeightQuery const* pQueries, float* pResults, uint32 count) override;
 
             bool processCommand(char* /*pCommand*/) override { return false; }      // for debug and extensions
 
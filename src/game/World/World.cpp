@@ -21,6 +21,7 @@
 */
 
 #include "World/World.h"
+#include "World/WorldLoadGraph.h"
 #include "Database/DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Models/M2Stores.h"
@@ -30,6 +31,7 @@
 #include "Server/Opcodes.h"
 #include "Server/WorldSession.h"
 #include "Server/WorldPacket.h"
+#include "Server/WorldSocket.h"
 #include "Entities/Player.h"
 #include "Skills/SkillExtraItems.h"
 #include "Skills/SkillDiscovery.h"
@@ -57,6 +59,8 @@
 #include "GameEvents/GameEventMgr.h"
 #include "Pools/PoolManager.h"
 #include "Database/DatabaseImpl.h"
+#include "Database/WorldSnapshot.h"
+#include "revision_sql.h"
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Maps/MapPersistentStateMgr.h"
@@ -510,6 +514,9 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 100);
+    setConfig(CONFIG_BOOL_COMPRESSION_IN_NETWORK_THREAD, "Compression.InNetworkThread", false);
+    setConfig(CONFIG_UINT32_MOVEMENT_AGGREGATION_DELAY, "Compression.MovementDelay", 0);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -664,6 +671,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_NUM_LOAD_THREADS, "LoadThreads", 1);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -918,6 +926,8 @@ void World::LoadConfigSettings(bool reload)
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
+    setConfig(CONFIG_BOOL_MEMORY_MAPPED_MAPS, "maps.memoryMapped", false);
+
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     setConfig(CONFIG_BOOL_PRELOAD_MMAP_TILES, "mmap.preload", false);
@@ -928,6 +938,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_BOOL_PATH_FIND_ASYNC, "PathFinder.Async", false);
 
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL, "Raf.BonusLevel", 60);
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE, "Raf.LevelDifference", 4);
@@ -1181,6 +1192,11 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Use the world snapshot for immutable world tables, it is rebuilt when the world database revision changes
+    std::string snapshotFile = sConfig.GetStringDefault("WorldSnapshot.File");
+    if (!snapshotFile.empty())
+        sWorldSnapshot.Open(snapshotFile, std::string(REVISION_DB_MANGOS) + '|' + m_DBVersion + '|' + m_CreatureEventAIVersion);
+
     ///- Check the existence of the map files for all races start areas.
     if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||                     // Dwarf/ Gnome
             !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||                // Human
@@ -1535,138 +1551,102 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading spell pet auras...");
     sSpellMgr.LoadSpellPetAuras();
 
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
-
     CharacterDatabaseCleaner::CleanDatabase();
     sLog.outString();
 
     sLog.outString("Loading the max pet number...");
     sObjectMgr.LoadPetNumber();
 
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
-
     sLog.outString("Loading Player Corpses...");
     sObjectMgr.LoadCorpses();
 
-    sLog.outString("Loading Player level dependent mail rewards...");
-    sObjectMgr.LoadMailLevelRewards();
-
-    sLog.outString("Loading Loot Tables...");
+    ///- Steps below only depend on data loaded above and on the steps named as after, independent ones are loaded in parallel
     LootIdSet ids_set;
-    LoadLootTables(ids_set);
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Achievements...");
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString(">>> Achievements loaded");
-    sLog.outString();
-
-    sLog.outString("Loading access requirements...");
-    sObjectMgr.LoadAccessRequirements();                    // must be after achievements
-
-    sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString("Loading Scripts random templates...");  // must be before String calls
-    sScriptMgr.LoadDbScriptRandomTemplates();
-    ///- Load and initialize DBScripts Engine
-    sLog.outString("Loading DB-Scripts Engine...");
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement 
-    sLog.outString(">>> Scripts loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sScriptMgr.LoadDbScriptStrings();
-
-    sLog.outString("Loading Gossip Menus...");
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString("Loading Waypoint scripts...");
-
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
-
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
-
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
-
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry(false);
+    WorldLoadGraph loadGraph;
+
+    loadGraph.AddStep("Player Create Info & Level Stats", []() { sObjectMgr.LoadPlayerInfo(); });
+    loadGraph.AddStep("Exploration BaseXP Data", []() { sObjectMgr.LoadExplorationBaseXP(); });
+    loadGraph.AddStep("Pet Name Parts", []() { sObjectMgr.LoadPetNames(); });
+    loadGraph.AddStep("pet level stats", []() { sObjectMgr.LoadPetLevelInfo(); });
+    loadGraph.AddStep("Player level dependent mail rewards", []() { sObjectMgr.LoadMailLevelRewards(); });
+    loadGraph.AddStep("Loot Tables", [&ids_set]() { LoadLootTables(ids_set); });
+    loadGraph.AddStep("Skill Discovery Table", []() { LoadSkillDiscoveryTable(); });
+    loadGraph.AddStep("Skill Extra Item Table", []() { LoadSkillExtraItemTable(); });
+    loadGraph.AddStep("Skill Fishing base level requirements", []() { sObjectMgr.LoadFishingBaseSkillLevel(); });
+
+    loadGraph.AddStep("Achievements", []()
+    {
+        sAchievementMgr.LoadAchievementReferenceList();
+        sAchievementMgr.LoadAchievementCriteriaList();
+        sAchievementMgr.LoadAchievementCriteriaRequirements();
+        sAchievementMgr.LoadRewards();
+        sAchievementMgr.LoadRewardLocales();
+        sAchievementMgr.LoadCompletedAchievements();
+    });
 
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes(false);
+    loadGraph.AddStep("access requirements", []() { sObjectMgr.LoadAccessRequirements(); }, { "Achievements" });
+    loadGraph.AddStep("Instance encounters data", []() { sObjectMgr.LoadInstanceEncounters(); });
+    loadGraph.AddStep("Npc Text Id", []() { sObjectMgr.LoadNpcGossips(); });
+
+    loadGraph.AddStep("DB-Scripts Engine", []()
+    {
+        sScriptMgr.LoadDbScriptRandomTemplates();                   // must be before String calls
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement
+        sScriptMgr.LoadDbScriptStrings();                           // must be after Load*Scripts calls
+    });
 
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loadGraph.AddStep("Gossip Menus", []() { sObjectMgr.LoadGossipMenus(); }, { "DB-Scripts Engine" });
 
-    sLog.outString("Loading Questgiver Greetings...");
-    sObjectMgr.LoadQuestgiverGreeting();
+    loadGraph.AddStep("Vendors", []()
+    {
+        sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
+        sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    });
 
-    sLog.outString("Loading Trainer Greetings...");
-    sObjectMgr.LoadTrainerGreetings();
+    loadGraph.AddStep("Trainers", []()
+    {
+        sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
+        sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+    });
 
-    ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sObjectMgr.LoadQuestgiverGreetingLocales();
-    sObjectMgr.LoadTrainerGreetingLocales();                // must be after CreatureInfo loading
-    sObjectMgr.LoadBroadcastTextLocales();
-    sLog.outString(">>> Localization strings loaded");
-    sLog.outString();
+    loadGraph.AddStep("Waypoints", []() { sWaypointMgr.Load(); }, { "DB-Scripts Engine" });
+    loadGraph.AddStep("ReservedNames", []() { sObjectMgr.LoadReservedPlayersNames(); });
+    loadGraph.AddStep("GameObjects for quests", []() { sObjectMgr.LoadGameObjectForQuests(); }, { "Loot Tables" });
+    loadGraph.AddStep("BattleMasters", []() { sBattleGroundMgr.LoadBattleMastersEntry(false); });
+    loadGraph.AddStep("BattleGround event indexes", []() { sBattleGroundMgr.LoadBattleEventIndexes(false); });
+    loadGraph.AddStep("GameTeleports", []() { sObjectMgr.LoadGameTele(); });
+    loadGraph.AddStep("Questgiver Greetings", []() { sObjectMgr.LoadQuestgiverGreeting(); });
+    loadGraph.AddStep("Trainer Greetings", []() { sObjectMgr.LoadTrainerGreetings(); });
+
+    // locale loaders share the locale index list of ObjectMgr, so achievement reward locales go first
+    loadGraph.AddStep("Localization strings", []()
+    {
+        sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
+        sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
+        sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
+        sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
+        sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
+        sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
+        sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
+        sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
+        sObjectMgr.LoadQuestgiverGreetingLocales();
+        sObjectMgr.LoadTrainerGreetingLocales();                // must be after CreatureInfo loading
+        sObjectMgr.LoadBroadcastTextLocales();
+    }, { "Gossip Menus", "Questgiver Greetings", "Trainer Greetings", "Achievements" });
+
+    loadGraph.Run(getConfig(CONFIG_UINT32_NUM_LOAD_THREADS));
+
+    ///- Everything after this point is either dynamic or reloadable, save the snapshot if anything was missing
+    sWorldSnapshot.Close();
 
     ///- Load dynamic data tables from the database
     sLog.outString("Loading Auctions...");
@@ -2123,20 +2103,21 @@ void World::Update(uint32 diff)
     sTerrainMgr.Update(diff);
 #ifdef BUILD_METRICS
     auto updateEndTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
-    long long total = (updateEndTime - m_currentTime).count();
-    long long presession = (preSessionTime - m_currentTime).count();
-    long long premap = (preMapTime - preSessionTime).count();
-    long long map = (postMapTime - preMapTime).count();
-    long long singletons = (postSingletonTime - postMapTime).count();
-    long long cleanup = (updateEndTime - postSingletonTime).count();
-
-    metric::measurement meas("world.update");
-    meas.add_field("total", std::to_string(total));
-    meas.add_field("presession", std::to_string(presession));
-    meas.add_field("premap", std::to_string(premap));
-    meas.add_field("map", std::to_string(map));
-    meas.add_field("singletons", std::to_string(singletons));
-    meas.add_field("cleanup", std::to_string(cleanup));
+    if (!m_updateStageMetrics[UPDATE_STAGE_TOTAL])
+    {
+        char const* stageNames[UPDATE_STAGE_MAX] = { "total", "presession", "premap", "map", "singletons", "cleanup" };
+        // milliseconds
+        std::vector<int64> bounds = { 5, 10, 20, 50, 100, 200, 500, 1000 };
+        for (uint32 i = 0; i < UPDATE_STAGE_MAX; ++i)
+            m_updateStageMetrics[i] = metric::metric::instance().register_histogram("world.update", { { "stage", stageNames[i] } }, bounds);
+    }
+
+    m_updateStageMetrics[UPDATE_STAGE_TOTAL]->record((updateEndTime - m_currentTime).count());
+    m_updateStageMetrics[UPDATE_STAGE_PRESESSION]->record((preSessionTime - m_currentTime).count());
+    m_updateStageMetrics[UPDATE_STAGE_PREMAP]->record((preMapTime - preSessionTime).count());
+    m_updateStageMetrics[UPDATE_STAGE_MAP]->record((postMapTime - preMapTime).count());
+    m_updateStageMetrics[UPDATE_STAGE_SINGLETONS]->record((postSingletonTime - postMapTime).count());
+    m_updateStageMetrics[UPDATE_STAGE_CLEANUP]->record((updateEndTime - postSingletonTime).count());
 #endif
 }
 
@@ -3199,6 +3180,12 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    WorldSocket::WriteStats writeStats = WorldSocket::ConsumeWriteStats();
+    metric::measurement meas_sent("world.metrics.packets.sent");
+    meas_sent.add_field("packets", std::to_string(writeStats.packets));
+    meas_sent.add_field("bytes", std::to_string(writeStats.bytes));
+    meas_sent.add_field("writes", std::to_string(writeStats.flushes));
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
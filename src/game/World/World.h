@@ -36,6 +36,9 @@
 #ifdef BUILD_ELUNA
 #include "LuaEngine/ElunaMgr.h"
 #endif
+#ifdef BUILD_METRICS
+#include "Metric/Series.h"
+#endif
 
 #include <set>
 #include <list>
@@ -104,6 +107,8 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_THRESHOLD,
+    CONFIG_UINT32_MOVEMENT_AGGREGATION_DELAY,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
@@ -159,6 +164,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_NUM_LOAD_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -640,11 +646,14 @@ enum eConfigBoolValues
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_PATH_FIND_ASYNC,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
     CONFIG_BOOL_PRELOAD_MMAP_TILES,
     CONFIG_BOOL_SPECIALS_ACTIVE,
     CONFIG_BOOL_REGEN_ZONE_AREA_ON_STARTUP,
+    CONFIG_BOOL_COMPRESSION_IN_NETWORK_THREAD,
+    CONFIG_BOOL_MEMORY_MAPPED_MAPS,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -1030,6 +1039,21 @@ class World
 
         Messager<World> m_messager;
 
+#ifdef BUILD_METRICS
+        enum UpdateStage
+        {
+            UPDATE_STAGE_TOTAL,
+            UPDATE_STAGE_PRESESSION,
+            UPDATE_STAGE_PREMAP,
+            UPDATE_STAGE_MAP,
+            UPDATE_STAGE_SINGLETONS,
+            UPDATE_STAGE_CLEANUP,
+            UPDATE_STAGE_MAX
+        };
+        // registered at first update, once the metric config is loaded
+        std::shared_ptr<metric::histogram> m_updateStageMetrics[UPDATE_STAGE_MAX];
+#endif
+
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
         // online count logging
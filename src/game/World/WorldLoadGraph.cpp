@@ -0,0 +1,163 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoadGraph.h"
+#include "Database/DatabaseEnv.h"
+#include "Log/Log.h"
+#include "Util/ProgressBar.h"
+#include "Util/Timer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+void WorldLoadGraph::AddStep(char const* name, LoadFunc&& func, std::initializer_list<char const*> after)
+{
+    size_t index = m_steps.size();
+    m_steps.emplace_back(name, std::move(func));
+
+    for (char const* afterName : after)
+    {
+        auto itr = std::find_if(m_steps.begin(), m_steps.begin() + index, [afterName](Step const& step) { return step.name == afterName; });
+        MANGOS_ASSERT(itr != m_steps.begin() + index);
+
+        size_t afterIndex = std::distance(m_steps.begin(), itr);
+        m_steps[index].after.push_back(afterIndex);
+        m_steps[afterIndex].dependents.push_back(index);
+    }
+}
+
+void WorldLoadGraph::RunStep(Step& step)
+{
+    sLog.outString("Loading %s...", step.name.c_str());
+
+    uint32 startTime = WorldTimer::getMSTime();
+    step.func();
+    step.duration = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void WorldLoadGraph::Run(uint32 threadCount)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (threadCount <= 1 || m_steps.size() <= 1)
+    {
+        for (Step& step : m_steps)
+            RunStep(step);
+
+        ReportTimings(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable stepDone;
+    std::deque<size_t> ready;
+    size_t remaining = m_steps.size();
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        m_steps[i].pendingAfter = m_steps[i].after.size();
+        if (!m_steps[i].pendingAfter)
+            ready.push_back(i);
+    }
+
+    // progress bars of concurrent steps would overwrite each other
+    bool showProgress = BarGoLink::GetOutputState();
+    BarGoLink::SetOutputState(false);
+
+    auto worker = [&]()
+    {
+        WorldDatabase.ThreadStart();                        // let thread do safe mySQL requests
+
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            stepDone.wait(guard, [&]() { return !ready.empty() || !remaining; });
+            if (ready.empty())
+                break;
+
+            size_t index = ready.front();
+            ready.pop_front();
+
+            guard.unlock();
+            RunStep(m_steps[index]);
+            guard.lock();
+
+            for (size_t dependent : m_steps[index].dependents)
+                if (!--m_steps[dependent].pendingAfter)
+                    ready.push_back(dependent);
+
+            --remaining;
+            stepDone.notify_all();
+        }
+
+        guard.unlock();
+        WorldDatabase.ThreadEnd();                          // free mySQL thread resources
+    };
+
+    std::vector<std::thread> threads;
+    threadCount = std::min<uint32>(threadCount, m_steps.size());
+    for (uint32 i = 0; i < threadCount; ++i)
+        threads.emplace_back(worker);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    BarGoLink::SetOutputState(showProgress);
+
+    ReportTimings(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+}
+
+void WorldLoadGraph::ReportTimings(uint32 wallTime) const
+{
+    // longest chain of measured durations along the after constraints, the lower bound for the stage with unlimited threads
+    std::vector<uint32> pathTime(m_steps.size(), 0);
+    std::vector<size_t> pathPrev(m_steps.size(), m_steps.size());
+    size_t pathEnd = 0;
+    uint32 totalTime = 0;
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        Step const& step = m_steps[i];
+        for (size_t afterIndex : step.after)
+        {
+            if (pathTime[afterIndex] > pathTime[i])
+            {
+                pathTime[i] = pathTime[afterIndex];
+                pathPrev[i] = afterIndex;
+            }
+        }
+
+        pathTime[i] += step.duration;
+        totalTime += step.duration;
+        if (pathTime[i] > pathTime[pathEnd])
+            pathEnd = i;
+
+        sLog.outDetail("Load step %s: %u ms", step.name.c_str(), step.duration);
+    }
+
+    std::string path;
+    for (size_t i = pathEnd; i < m_steps.size(); i = pathPrev[i])
+        path = m_steps[i].name + (path.empty() ? "" : " -> ") + path;
+
+    sLog.outString(">> Loaded %u steps in %u ms (%u ms sequential), critical path %u ms: %s",
+                   uint32(m_steps.size()), wallTime, totalTime, m_steps.empty() ? 0 : pathTime[pathEnd], path.c_str());
+    sLog.outString();
+}
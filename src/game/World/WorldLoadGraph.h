@@ -0,0 +1,58 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLD_LOAD_GRAPH_H
+#define MANGOS_WORLD_LOAD_GRAPH_H
+
+#include "Common.h"
+
+#include <functional>
+#include <initializer_list>
+
+// startup load steps with their "must be after" constraints, steps without a path between them run in parallel
+class WorldLoadGraph
+{
+    public:
+        typedef std::function<void()> LoadFunc;
+
+        // steps named in after have to be added before, so the insertion order is always a valid load order
+        void AddStep(char const* name, LoadFunc&& func, std::initializer_list<char const*> after = {});
+
+        // threadCount <= 1 runs all steps in insertion order on the calling thread
+        void Run(uint32 threadCount);
+
+    private:
+        struct Step
+        {
+            Step(char const* _name, LoadFunc&& _func) : name(_name), func(std::move(_func)), pendingAfter(0), duration(0) {}
+
+            std::string name;
+            LoadFunc func;
+            std::vector<size_t> after;
+            std::vector<size_t> dependents;
+            uint32 pendingAfter;                            // unfinished steps of after, only used while running
+            uint32 duration;                                // ms
+        };
+
+        void RunStep(Step& step);
+        void ReportTimings(uint32 wallTime) const;
+
+        std::vector<Step> m_steps;
+};
+
+#endif
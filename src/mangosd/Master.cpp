@@ -41,6 +41,9 @@
 #include "Policies/Singleton.h"
 #include "Network/AsyncListener.hpp"
 #include "Network/AsyncSocket.hpp"
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
 
 #include <boost/thread.hpp>
 
@@ -227,11 +230,10 @@ int Master::Run()
         }
         std::string bindIp = sConfig.GetStringDefault("BindIP", "0.0.0.0");
         int32 port = int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD));
-        MaNGOS::AsyncListener<WorldSocket> listener(m_context, bindIp, port);
-
-        std::vector<std::thread> threads;
-        for (int32 i = 0; i < networkThreadCount; ++i)
-            threads.emplace_back([&]() { m_context.run(); });
+        // each network thread runs its own io_context, new connections go to the least loaded one
+        m_networkPool = std::make_unique<MaNGOS::AsyncContextPool>(networkThreadCount);
+        MaNGOS::AsyncListener<WorldSocket> listener(*m_networkPool, bindIp, port);
+        m_networkPool->Start();
 
         std::unique_ptr<MaNGOS::AsyncListener<RASocket>> raListener;
         std::string raBindIp = sConfig.GetStringDefault("Ra.IP", "0.0.0.0");
@@ -250,20 +252,26 @@ int Master::Run()
 
         // wait for shut down and then let things go out of scope to close them down
         while (!World::IsStopped())
+        {
             std::this_thread::sleep_for(std::chrono::seconds(1));
+#ifdef BUILD_METRICS
+            for (size_t i = 0; i < m_networkPool->GetShardCount(); ++i)
+            {
+                metric::measurement meas("world.metrics.network", { {"shard", std::to_string(i)} });
+                meas.add_field("connections", std::to_string(m_networkPool->GetShardLoad(i)));
+            }
+#endif
+        }
 
         world_thread.wait();
 
-        m_context.stop();
+        m_networkPool->Stop();
 
         if (raEnable)
         {
             m_raContext.stop();
             m_raThread.join();
         }
-
-        for (int32 i = 0; i < networkThreadCount; ++i)
-            threads[i].join();
     }
 
     ///- Stop freeze protection before shutdown tasks
@@ -339,15 +347,16 @@ bool Master::_StartDB()
     ///- Get world database info from configuration file
     std::string dbstring = sConfig.GetStringDefault("WorldDatabaseInfo");
     int nConnections = sConfig.GetIntDefault("WorldDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("WorldDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Database not specified in configuration file");
         return false;
     }
-    sLog.outString("World Database total connections: %i", nConnections + 1);
+    sLog.outString("World Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the world database
-    if (!WorldDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!WorldDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to world database %s", dbstring.c_str());
         return false;
@@ -362,6 +371,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -370,10 +380,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -393,6 +403,7 @@ bool Master::_StartDB()
     ///- Get login database info from configuration file
     dbstring = sConfig.GetStringDefault("LoginDatabaseInfo");
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("LoginDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Login database not specified in configuration file");
@@ -404,8 +415,8 @@ bool Master::_StartDB()
     }
 
     ///- Initialise the login database
-    sLog.outString("Login Database total connections: %i", nConnections + 1);
-    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
+    sLog.outString("Login Database total connections: %i", nConnections + nAsyncConnections);
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to login database %s", dbstring.c_str());
 
@@ -427,6 +438,7 @@ bool Master::_StartDB()
     ///- Get logs database info from configuration file
     dbstring = sConfig.GetStringDefault("LogsDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("LogsDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("LogsDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("logs database not specified in configuration file");
@@ -439,8 +451,8 @@ bool Master::_StartDB()
     }
 
     ///- Initialise the logs database
-    sLog.outString("Logs Database total connections: %i", nConnections + 1);
-    if (!LogsDatabase.Initialize(dbstring.c_str(), nConnections))
+    sLog.outString("Logs Database total connections: %i", nConnections + nAsyncConnections);
+    if (!LogsDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to logs database %s", dbstring.c_str());
 
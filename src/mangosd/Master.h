@@ -25,8 +25,10 @@
 
 #include "Common.h"
 #include "Policies/Singleton.h"
+#include "Network/AsyncContextPool.hpp"
 
 #include <boost/asio.hpp>
+#include <memory>
 
 /// Start the server
 class Master
@@ -44,7 +46,7 @@ class Master
 
         void clearOnlineAccounts();
 
-        boost::asio::io_context m_context;
+        std::unique_ptr<MaNGOS::AsyncContextPool> m_networkPool;
         boost::asio::io_context m_raContext;
 };
 
@@ -33,6 +33,7 @@
 #include "Util/CommonDefines.h"
 
 #include <openssl/md5.h>
+#include <cstdarg>
 #include <ctime>
 #include <memory>
 #include <utility>
@@ -407,142 +408,157 @@ bool AuthSocket::_HandleLogonChallenge()
 
             ///- Verify that this IP is not in the ip_banned table
             // No SQL injection possible (paste the IP address as passed by the socket)
-            std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", self->GetRemoteAddress().c_str()));
-
-            if (ip_banned_result)
-            {
-                *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
-            }
-            else
+            self->QueryAsync([self, pkt](QueryResult* ipBannedResult)
             {
+                if (ipBannedResult)
+                {
+                    *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                    BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
+                    self->sendChallengeResult(pkt);
+                    return;
+                }
+
                 ///- Get the account details from the account table
                 // No SQL injection (escaped user name)
-                auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", self->_safelogin.c_str());
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
+                self->QueryAsync([self, pkt](QueryResult* accountResult) { self->checkAccountForChallenge(pkt, accountResult); },
+                    "SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", self->_safelogin.c_str());
+            }, "SELECT expires_at FROM ip_banned "
+                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", self->GetRemoteAddress().c_str());
+        });
+    });
 
-                    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-                    bool locked = false;
-                    if (fields[1].GetUInt8() == 1)               // if ip is locked
-                    {
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
-                        DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
-                        if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
-                        {
-                            DEBUG_LOG("[AuthChallenge] Account IP differs");
-                            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                            locked = true;
-                        }
-                        else
-                            DEBUG_LOG("[AuthChallenge] Account IP matches");
-                    }
-                    else
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
+    return true;
+}
 
-                    std::string databaseV = fields[4].GetCppString();
-                    std::string databaseS = fields[5].GetCppString();
-                    bool broken = false;
+void AuthSocket::checkAccountForChallenge(std::shared_ptr<ByteBuffer> pkt, QueryResult* accountResult)
+{
+    if (!accountResult)                                     // no account
+    {
+        *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
+        sendChallengeResult(pkt);
+        return;
+    }
 
-                    if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
-                    {
-                        *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                        DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
-                        broken = true;
-                    }
+    Field* fields = accountResult->Fetch();
 
-                    if (!locked && !broken)
-                    {
-                        ///- If the account is banned, reject the logon attempt
-                        auto banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                            "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", fields[0].GetUInt32());
-                        if (banresult)
-                        {
-                            if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
-                                BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
-                            }
-                            else
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                                BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
-                            }
-                        }
-                        else
-                        {
-                            DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                            BigNumber s;
-                            s.SetHexStr(databaseS.c_str());
-
-                            self->srp.CalculateHostPublicEphemeral();
-
-                            ///- Fill the response packet with the result
-                            *pkt << uint8(AUTH_LOGON_SUCCESS);
-
-                            // B may be calculated < 32B so we force minimal length to 32B
-                            pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
-                            *pkt << uint8(1);
-                            pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
-                            *pkt << uint8(32);
-                            pkt->append(self->srp.GetPrime().AsByteArray(32));
-                            pkt->append(s.AsByteArray());// 32 bytes
-                            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-                            uint8 securityFlags = 0;
-
-                            self->_token = fields[6].GetCppString();
-                            if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
-                                securityFlags = SECURITY_FLAG_AUTHENTICATOR;
-
-                            if (!self->_token.empty() && self->_build <= 6141)
-                                securityFlags = SECURITY_FLAG_PIN;
-
-                            *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
-
-                            if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
-                            {
-                                uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
-                                EndianConvert(gridSeedPkt);
-                                self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
-                                self->m_promptPin = true;
-
-                                *pkt << gridSeedPkt;
-                                pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
-                            }
-
-                            if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
-                            {
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint64(0);
-                            }
-
-                            if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                                *pkt << uint8(1);
-
-                            uint8 secLevel = fields[3].GetUInt8();
-                            self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                            ///- All good, await client's proof
-                            self->_status = STATUS_LOGON_PROOF;
-                        }
-                    }
-                }
-                else                                                // no account
-                    *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
-            }
+    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+    if (fields[1].GetUInt8() == 1)                          // if ip is locked
+    {
+        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[2].GetString());
+        DEBUG_LOG("[AuthChallenge] Player address is '%s'", GetRemoteAddress().c_str());
+        if (strcmp(fields[2].GetString(), GetRemoteAddress().c_str()))
+        {
+            DEBUG_LOG("[AuthChallenge] Account IP differs");
+            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+            sendChallengeResult(pkt);
+            return;
+        }
+        DEBUG_LOG("[AuthChallenge] Account IP matches");
+    }
+    else
+        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
 
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-            self->ProcessIncomingData();
-        });
-    });
+    std::string databaseV = fields[4].GetCppString();
+    std::string databaseS = fields[5].GetCppString();
 
-    return true;
+    if (!srp.SetVerifier(databaseV.c_str()) || !srp.SetSalt(databaseS.c_str()))
+    {
+        *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+        DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", _login.c_str());
+        sendChallengeResult(pkt);
+        return;
+    }
+
+    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+    m_accountId = fields[0].GetUInt32();
+    _token = fields[6].GetCppString();
+    uint8 secLevel = fields[3].GetUInt8();
+    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+    ///- If the account is banned, reject the logon attempt
+    QueryAsync([self = shared_from_this(), pkt, databaseS](QueryResult* banResult) { self->checkAccountBanForChallenge(pkt, banResult, databaseS); },
+        "SELECT banned_at,expires_at FROM account_banned WHERE "
+        "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", m_accountId);
+}
+
+void AuthSocket::checkAccountBanForChallenge(std::shared_ptr<ByteBuffer> pkt, QueryResult* banResult, std::string const& databaseS)
+{
+    if (banResult)
+    {
+        if ((*banResult)[0].GetUInt64() == (*banResult)[1].GetUInt64())
+        {
+            *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
+            BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
+        }
+        else
+        {
+            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+            BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
+        }
+        sendChallengeResult(pkt);
+        return;
+    }
+
+    BigNumber s;
+    s.SetHexStr(databaseS.c_str());
+
+    srp.CalculateHostPublicEphemeral();
+
+    ///- Fill the response packet with the result
+    *pkt << uint8(AUTH_LOGON_SUCCESS);
+
+    // B may be calculated < 32B so we force minimal length to 32B
+    pkt->append(srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
+    *pkt << uint8(1);
+    pkt->append(srp.GetGeneratorModulo().AsByteArray());
+    *pkt << uint8(32);
+    pkt->append(srp.GetPrime().AsByteArray(32));
+    pkt->append(s.AsByteArray());// 32 bytes
+    pkt->append(VersionChallenge.data(), VersionChallenge.size());
+    uint8 securityFlags = 0;
+
+    if (!_token.empty() && _build >= 8606)                  // authenticator was added in 2.4.3
+        securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+
+    if (!_token.empty() && _build <= 6141)
+        securityFlags = SECURITY_FLAG_PIN;
+
+    *pkt << uint8(securityFlags);                           // security flags (0x0...0x04)
+
+    if (securityFlags & SECURITY_FLAG_PIN)                  // PIN input
+    {
+        uint32 gridSeedPkt = m_gridSeed = static_cast<uint32>(0);
+        EndianConvert(gridSeedPkt);
+        m_serverSecuritySalt.SetRand(16 * 8);               // 16 bytes random
+        m_promptPin = true;
+
+        *pkt << gridSeedPkt;
+        pkt->append(m_serverSecuritySalt.AsByteArray(16).data(), 16);
+    }
+
+    if (securityFlags & SECURITY_FLAG_UNK)                  // Matrix input
+    {
+        *pkt << uint8(0);
+        *pkt << uint8(0);
+        *pkt << uint8(0);
+        *pkt << uint8(0);
+        *pkt << uint64(0);
+    }
+
+    if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)        // Authenticator input
+        *pkt << uint8(1);
+
+    ///- All good, await client's proof
+    _status = STATUS_LOGON_PROOF;
+
+    sendChallengeResult(pkt);
+}
+
+void AuthSocket::sendChallengeResult(std::shared_ptr<ByteBuffer> pkt)
+{
+    Write((const char*)pkt->contents(), pkt->size(), [self = shared_from_this(), pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+    ProcessIncomingData();
 }
 
 /// Logon Proof command handler
@@ -658,10 +674,16 @@ bool AuthSocket::_HandleLogonProof()
             if (MaxWrongPassCount > 0)
             {
                 // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+                // same order key as the select below, so it counts this attempt
+                LoginDatabase.BeginTransaction(self->GetOrderKey());
                 LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", self->_safelogin.c_str());
+                LoginDatabase.CommitTransaction();
 
-                if (auto loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", self->_safelogin.c_str()))
+                self->QueryAsync([self, MaxWrongPassCount](QueryResult* loginfail)
                 {
+                    if (!loginfail)
+                        return;
+
                     Field* fields = loginfail->Fetch();
                     uint32 failed_logins = fields[1].GetUInt32();
 
@@ -673,9 +695,12 @@ bool AuthSocket::_HandleLogonProof()
                         if (WrongPassBanType)
                         {
                             uint32 acc_id = fields[0].GetUInt32();
+                            // same key as the ban check of the account's next logon challenge
+                            LoginDatabase.BeginTransaction(self->GetOrderKey());
                             LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
                                 "VALUES ('%u'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban',1)",
                                 acc_id, WrongPassBanTime);
+                            LoginDatabase.CommitTransaction();
                             BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
                                 self->_login.c_str(), WrongPassBanTime, failed_logins);
                         }
@@ -683,13 +708,15 @@ bool AuthSocket::_HandleLogonProof()
                         {
                             std::string current_ip = self->GetRemoteAddress();
                             LoginDatabase.escape_string(current_ip);
+                            LoginDatabase.BeginTransaction(self->GetOrderKey());
                             LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban')",
                                 current_ip.c_str(), WrongPassBanTime);
+                            LoginDatabase.CommitTransaction();
                             BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
                                 current_ip.c_str(), WrongPassBanTime, self->_login.c_str(), failed_logins);
                         }
                     }
-                }
+                }, "SELECT id, failed_logins FROM account WHERE username = '%s'", self->_safelogin.c_str());
             }
             self->ProcessIncomingData();
         }
@@ -750,32 +777,33 @@ bool AuthSocket::_HandleReconnectChallenge()
             EndianConvert(body->build);
             self->_build = body->build;
 
-            auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", self->_safelogin.c_str());
-
-            // Stop if the account is not found
-            if (!queryResult)
+            self->QueryAsync([self](QueryResult* queryResult)
             {
-                sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
-                self->Close();
-                return;
-            }
+                // Stop if the account is not found
+                if (!queryResult)
+                {
+                    sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
+                    self->Close();
+                    return;
+                }
 
-            Field* fields = queryResult->Fetch();
-            self->srp.SetStrongSessionKey(fields[0].GetString());
+                Field* fields = queryResult->Fetch();
+                self->srp.SetStrongSessionKey(fields[0].GetString());
 
-            ///- All good, await client's proof
-            self->_status = STATUS_RECON_PROOF;
+                ///- All good, await client's proof
+                self->_status = STATUS_RECON_PROOF;
 
-            ///- Sending response
-            std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
-            *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
-            *pkt << (uint8)0x00;
-            self->_reconnectProof.SetRand(16 * 8);
-            pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
-            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                ///- Sending response
+                std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+                *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
+                *pkt << (uint8)0x00;
+                self->_reconnectProof.SetRand(16 * 8);
+                pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
+                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
 
-            self->ProcessIncomingData();
+                self->ProcessIncomingData();
+            }, "SELECT sessionkey FROM account WHERE username = '%s'", self->_safelogin.c_str());
         });
     });
 
@@ -854,39 +882,69 @@ bool AuthSocket::_HandleRealmList()
 
         // Get the user id (else close the connection)
         // No SQL injection (escaped user name)
-
-        auto queryResult = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", self->_safelogin.c_str());
-        if (!queryResult)
+        self->QueryAsync([self](QueryResult* queryResult)
         {
-            sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
-            self->Close();
-            return;
-        }
-
-        uint32 id = (*queryResult)[0].GetUInt32();
-        uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
+            if (!queryResult)
+            {
+                sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
+                self->Close();
+                return;
+            }
 
-        ///- Update realm list if need
-        sRealmList.UpdateIfNeed();
+            uint32 id = (*queryResult)[0].GetUInt32();
+            uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
 
-        ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-        ByteBuffer pkt;
-        self->LoadRealmlist(pkt, id, accountSecurityLevel);
+            // clients repeat the request while the realm list is open, answer those from the cache
+            RealmList::CharacterCounts characterCounts;
+            if (sRealmList.GetCachedCharacterCounts(id, characterCounts))
+            {
+                self->sendRealmList(characterCounts, accountSecurityLevel);
+                return;
+            }
 
-        std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
-        *hdr << (uint8)CMD_REALM_LIST;
-        *hdr << (uint16)pkt.size();
-        hdr->append(pkt);
+            // one query for the characters on all realms
+            self->QueryAsync([self, id, accountSecurityLevel](QueryResult* countResult)
+            {
+                RealmList::CharacterCounts characterCounts;
+                if (countResult)
+                {
+                    do
+                    {
+                        Field* fields = countResult->Fetch();
+                        characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+                    }
+                    while (countResult->NextRow());
+                }
 
-        self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-        self->ProcessIncomingData();
+                sRealmList.CacheCharacterCounts(id, characterCounts);
+                self->sendRealmList(characterCounts, accountSecurityLevel);
+            }, "SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", id);
+        }, "SELECT id, gmlevel FROM account WHERE username = '%s'", self->_safelogin.c_str());
     });
 
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
+void AuthSocket::sendRealmList(RealmList::CharacterCounts const& characterCounts, uint8 accountSecurityLevel)
+{
+    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+    ByteBuffer pkt;
+    LoadRealmlist(pkt, characterCounts, accountSecurityLevel);
+
+    std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
+    *hdr << (uint8)CMD_REALM_LIST;
+    *hdr << (uint16)pkt.size();
+    hdr->append(pkt);
+
+    Write((const char*)hdr->contents(), hdr->size(), [self = shared_from_this(), hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+    ProcessIncomingData();
+}
+
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, RealmList::CharacterCounts const& characterCounts, uint8 securityLevel)
 {
+    // the main thread may publish a new list meanwhile, keep using this one
+    RealmList::RealmMapPtr realms = sRealmList.GetRealms();
+
     switch (_build)
     {
         case 5875:                                          // 1.12.1
@@ -894,21 +952,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
         case 6141:                                          // 1.12.3
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint8(getEligibleRealmCount(securityLevel));
+            pkt << uint8(getEligibleRealmCount(*realms, securityLevel));
 
-            for (const auto& i : sRealmList)
+            for (const auto& i : *realms)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto countItr = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -960,21 +1009,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
         default:                                            // and later
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint16(getEligibleRealmCount(securityLevel));
+            pkt << uint16(getEligibleRealmCount(*realms, securityLevel));
 
-            for (const auto& i : sRealmList)
+            for (const auto& i : *realms)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto countItr = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -1024,10 +1064,10 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
     }
 }
 
-uint8 AuthSocket::getEligibleRealmCount(uint8 accountSecurityLevel)
+uint8 AuthSocket::getEligibleRealmCount(RealmList::RealmMap const& realms, uint8 accountSecurityLevel)
 {
     uint8 size = 0;
-    for (const auto& i : sRealmList)
+    for (const auto& i : realms)
         if (i.second.allowedSecurityLevel <= accountSecurityLevel)
             size++;
 
@@ -1149,12 +1189,13 @@ void AuthSocket::verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLog
 
     ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
     // No SQL injection (escaped user input) and IP address as received by socket
+    // Queued on the order key of this account, the realm list and reconnect queries that follow use the same
+    // connection and see the new session key before the client can reach the world server
     const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
-    // Note: In case of heavy load, this sync query will be a heavy bottleneck
-    LoginDatabase.DirectPExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-    std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-    if (loginfail)
-        LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s'," _NOW_ ",'%u')", loginfail->Fetch()[0].GetUInt32(), GetRemoteAddress().c_str(), LOGIN_TYPE_REALMD);
+    LoginDatabase.BeginTransaction(GetOrderKey());
+    LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
+    LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s'," _NOW_ ",'%u')", m_accountId, GetRemoteAddress().c_str(), LOGIN_TYPE_REALMD);
+    LoginDatabase.CommitTransaction();
     OPENSSL_free((void*)K_hex);
 
     ///- Finish SRP6 and send the final result to the client
@@ -1169,6 +1210,40 @@ void AuthSocket::verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLog
     ProcessIncomingData();
 }
 
+uint32 AuthSocket::GetOrderKey() const
+{
+    // key 0 is fenced against every other key, so it must never come out of the hash
+    uint32 key = uint32(std::hash<std::string>()(_safelogin));
+    return key ? key : 1;
+}
+
+void AuthSocket::QueryAsync(std::function<void(QueryResult*)>&& handler, const char* format, ...)
+{
+    va_list ap;
+    char szQuery[MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        Close();
+        return;
+    }
+
+    // the delay thread only runs the query, the handler continues on the io_context of this socket
+    LoginDatabase.AsyncQuery(GetOrderKey(), [self = shared_from_this(), handler = std::move(handler)](std::unique_ptr<QueryResult> queryResult)
+    {
+        std::shared_ptr<QueryResult> result(std::move(queryResult));
+        self->Post([self, handler, result]()
+        {
+            if (!self->IsClosed())
+                handler(result.get());
+        });
+    }, szQuery);
+}
+
 int32 AuthSocket::generateToken(char const* b32key)
 {
     size_t keySize = strlen(b32key);
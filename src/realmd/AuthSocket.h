@@ -28,6 +28,7 @@
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
 #include "Util/ByteBuffer.h"
+#include "RealmList.h"
 
 #include "Network/AsyncSocket.hpp"
 
@@ -39,6 +40,7 @@
 
 struct sAuthLogonProof_C;
 struct sAuthLogonPinData_C;
+class QueryResult;
 
 class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
 {
@@ -50,11 +52,11 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         bool OnOpen() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void LoadRealmlist(ByteBuffer& pkt, RealmList::CharacterCounts const& characterCounts, uint8 accountSecurityLevel = 0);
         bool VerifyPinData(uint32 pin, const sAuthLogonPinData_C& clientData);
         int32 generateToken(char const* b32key);
 
-        uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
+        uint8 getEligibleRealmCount(RealmList::RealmMap const& realms, uint8 accountSecurityLevel);
 
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
         bool _HandleLogonChallenge();
@@ -70,6 +72,15 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
 
     private:
         void verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLogonProof_C> lp);
+        void checkAccountForChallenge(std::shared_ptr<ByteBuffer> pkt, QueryResult* accountResult);
+        void checkAccountBanForChallenge(std::shared_ptr<ByteBuffer> pkt, QueryResult* banResult, std::string const& databaseS);
+        void sendChallengeResult(std::shared_ptr<ByteBuffer> pkt);
+        void sendRealmList(RealmList::CharacterCounts const& characterCounts, uint8 accountSecurityLevel);
+
+        /// Runs the query on a login database delay thread and resumes the handler on this socket's io_context,
+        /// queries of one account name keep their order. The result is only valid during the handler
+        void QueryAsync(std::function<void(QueryResult*)>&& handler, const char* format, ...) ATTR_PRINTF(3, 4);
+        uint32 GetOrderKey() const;
 
         enum eStatus
         {
@@ -95,6 +106,7 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         std::string _safelocale;
         uint16 _build;
         AccountTypes _accountSecurityLevel;
+        uint32 m_accountId = 0;
 
         BigNumber m_serverSecuritySalt;
         uint32 m_gridSeed = 0;
@@ -222,7 +222,7 @@ int main(int argc, char* argv[])
     }
 
     // Get the list of realms for the server
-    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20));
+    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20), sConfig.GetIntDefault("RealmList.CharacterCountCacheTime", 10));
     if (sRealmList.size() == 0)
     {
         sLog.outError("No valid realms specified.");
@@ -312,6 +312,9 @@ int main(int argc, char* argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+
+        // reload realm states here instead of in the realm list requests of the network threads
+        sRealmList.UpdateIfNeed();
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
@@ -365,9 +368,12 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    int nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("LoginDatabaseAsyncConnections", 1);
+
+    sLog.outString("Login Database total connections: %i", nConnections + nAsyncConnections);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
@@ -100,7 +100,7 @@ uint8 GetRealmCategoryIdByBuildAndZone(uint16 _build, RealmZone _realmZone)
     return buildInfo ? RealmCategoryIdsByRealmZoneByMajorVersion[buildInfo->major_version][_realmZone] : _realmZone;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+RealmList::RealmList() : m_realms(std::make_shared<RealmMap const>()), m_UpdateInterval(0), m_NextUpdateTime(time(nullptr)), m_characterCountCacheTime(0), m_nextCharacterCountsCleanup(0)
 {
 }
 
@@ -111,18 +111,19 @@ RealmList& sRealmList
 }
 
 /// Load the realm list from the database
-void RealmList::Initialize(uint32 updateInterval)
+void RealmList::Initialize(uint32 updateInterval, uint32 characterCountCacheTime)
 {
     m_UpdateInterval = updateInterval;
+    m_characterCountCacheTime = characterCountCacheTime;
 
     ///- Get the content of the realmlist table in the database
     UpdateRealms(true);
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
 {
     ///- Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID       = ID;
     realm.icon       = icon;
@@ -166,9 +167,6 @@ void RealmList::UpdateIfNeed()
 
     m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
 
-    // Clears Realm list
-    m_realms.clear();
-
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
 }
@@ -180,6 +178,9 @@ void RealmList::UpdateRealms(bool init)
     ////                                           0   1     2        3     4     5           6         7                     8           9
     auto queryResult = LoginDatabase.Query("SELECT id, name, address, port, icon, realmflags, timezone, allowedSecurityLevel, population, realmbuilds FROM realmlist WHERE (realmflags & 1) = 0 ORDER BY name");
 
+    // filled aside and published at once, network threads keep reading the previous list meanwhile
+    auto realms = std::make_shared<RealmMap>();
+
     ///- Circle through results and add them to the realm map
     if (queryResult)
     {
@@ -204,7 +205,7 @@ void RealmList::UpdateRealms(bool init)
                 realmflags &= (REALM_FLAG_OFFLINE | REALM_FLAG_NEW_PLAYERS | REALM_FLAG_RECOMMENDED | REALM_FLAG_SPECIFYBUILD);
             }
 
-            UpdateRealm(
+            UpdateRealm(*realms,
                 Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
                 fields[4].GetUInt8(), RealmFlags(realmflags), fields[6].GetUInt8(),
                 (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR),
@@ -215,4 +216,50 @@ void RealmList::UpdateRealms(bool init)
         }
         while (queryResult->NextRow());
     }
+
+    // network threads keep the list they copied, the old one is released by the last of them
+    std::lock_guard<std::mutex> guard(m_realmsLock);
+    m_realms = std::move(realms);
+}
+
+bool RealmList::GetCachedCharacterCounts(uint32 accountId, CharacterCounts& counts)
+{
+    if (!m_characterCountCacheTime)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_characterCountsLock);
+
+    auto itr = m_characterCounts.find(accountId);
+    if (itr == m_characterCounts.end() || itr->second.expireTime <= time(nullptr))
+        return false;
+
+    counts = itr->second.counts;
+    return true;
+}
+
+void RealmList::CacheCharacterCounts(uint32 accountId, CharacterCounts const& counts)
+{
+    if (!m_characterCountCacheTime)
+        return;
+
+    time_t now = time(nullptr);
+
+    std::lock_guard<std::mutex> guard(m_characterCountsLock);
+
+    // drop expired accounts once per cache period, the map only holds accounts that logged in recently
+    if (m_nextCharacterCountsCleanup <= now)
+    {
+        for (auto itr = m_characterCounts.begin(); itr != m_characterCounts.end();)
+        {
+            if (itr->second.expireTime <= now)
+                itr = m_characterCounts.erase(itr);
+            else
+                ++itr;
+        }
+        m_nextCharacterCountsCleanup = now + m_characterCountCacheTime;
+    }
+
+    CachedCharacterCounts& cached = m_characterCounts[accountId];
+    cached.counts = counts;
+    cached.expireTime = now + m_characterCountCacheTime;
 }
@@ -25,6 +25,9 @@
 
 #include "Common.h"
 #include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 struct RealmBuildInfo
 {
@@ -61,26 +64,49 @@ class RealmList
 {
     public:
         typedef std::map<std::string, Realm> RealmMap;
+        typedef std::shared_ptr<RealmMap const> RealmMapPtr;
+        typedef std::map<uint32, uint8> CharacterCounts;    // realm id -> characters of one account
 
         static RealmList& Instance();
 
         RealmList();
         ~RealmList() {}
 
-        void Initialize(uint32 updateInterval);
+        void Initialize(uint32 updateInterval, uint32 characterCountCacheTime);
 
+        // reloads the list from the timer of the main loop, never from network threads
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        // character counts of an account from a recent realm list request, false if none or expired
+        bool GetCachedCharacterCounts(uint32 accountId, CharacterCounts& counts);
+        void CacheCharacterCounts(uint32 accountId, CharacterCounts const& counts);
+
+        // the list is replaced as a whole on update, the returned one stays valid as long as it is held
+        RealmMapPtr GetRealms() const
+        {
+            std::lock_guard<std::mutex> guard(m_realmsLock);
+            return m_realms;
+        }
+        uint32 size() const { return GetRealms()->size(); }
     private:
         void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
     private:
-        RealmMap m_realms;                                  ///< Internal map of realms
+        struct CachedCharacterCounts
+        {
+            CharacterCounts counts;
+            time_t expireTime;
+        };
+
+        mutable std::mutex m_realmsLock;                    ///< Only guards swapping and copying the pointer, never the map itself
+        RealmMapPtr m_realms;                               ///< Internal map of realms, read by all network threads
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        std::mutex m_characterCountsLock;                   ///< Realm list requests are handled by all network threads
+        std::unordered_map<uint32, CachedCharacterCounts> m_characterCounts;
+        uint32   m_characterCountCacheTime;
+        time_t   m_nextCharacterCountsCleanup;
 };
 
 #define sRealmList RealmList::Instance()
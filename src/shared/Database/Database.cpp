@@ -97,7 +97,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -134,10 +134,23 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
-        return false;
+    // create and initialize connections for async requests, each one gets its own delay thread
+    if (nAsyncConns < MIN_CONNECTION_POOL_SIZE)
+        nAsyncConns = MIN_CONNECTION_POOL_SIZE;
+    else if (nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -150,10 +163,12 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
-
     m_pResultQueue = nullptr;
-    m_pAsyncConn = nullptr;
+
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
+        delete m_pAsyncConnection;
+
+    m_pAsyncConnections.clear();
 
     for (auto& m_pQueryConnection : m_pQueryConnections)
         delete m_pQueryConnection;
@@ -161,30 +176,56 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    // New delay thread for delay execute, first one keeps all connections alive
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        SqlDelayThread* threadBody = CreateDelayThread(m_pAsyncConnections[i], i == 0);
+        m_threadBodies.push_back(threadBody);               // will deleted at thread delete
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody));
+    }
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_delayThreads.empty()) return;
+
+    m_haltingDelayThreads = true;
+    for (auto threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    for (auto delayThread : m_delayThreads)
+    {
+        delayThread->wait();                                // Wait for flush to DB
+        delete delayThread;                                 // This also deletes its thread body
+    }
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+    m_haltingDelayThreads = false;
+}
+
+bool Database::DelayRequest(SqlOperation* sql, uint32 orderKey)
+{
+    if (orderKey || m_threadBodies.size() == 1 || m_haltingDelayThreads)
+        return getDelayThread(orderKey)->Delay(sql);
+
+    // keyed requests on other connections must not pass it in either direction
+    auto state = std::make_shared<SqlFence::State>(sql, m_threadBodies.size() - 1);
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+    std::lock_guard<std::mutex> guard(m_fenceLock);
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->Delay(new SqlFence(state, i == 0));
+    return true;
 }
 
 void Database::ThreadStart()
@@ -229,8 +270,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnection);
         guard->Query(sql);
     }
 
@@ -324,7 +366,7 @@ QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 
 bool Database::Execute(const char* sql)
 {
-    if (!m_pAsyncConn)
+    if (m_pAsyncConnections.empty())
         return false;
 
     auto const pTrans = m_currentTransaction.get();
@@ -340,7 +382,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayRequest(new SqlPlainRequest(sql), 0);
     }
 
     return true;
@@ -366,6 +408,34 @@ bool Database::PExecute(const char* format, ...)
     return Execute(szQuery);
 }
 
+bool Database::AsyncQuery(uint32 orderKey, QueryHandler&& handler, const char* sql)
+{
+    if (!sql || !handler || m_threadBodies.empty())
+        return false;
+
+    return DelayRequest(new SqlHandlerQuery(sql, std::move(handler)), orderKey);
+}
+
+bool Database::AsyncPQuery(uint32 orderKey, QueryHandler&& handler, const char* format, ...)
+{
+    if (!format)
+        return false;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return false;
+    }
+
+    return AsyncQuery(orderKey, std::move(handler), szQuery);
+}
+
 bool Database::DirectPExecute(const char* format, ...)
 {
     if (!format)
@@ -386,36 +456,36 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 orderKey /*= 0*/)
 {
-    if (!m_pAsyncConn)
+    if (m_pAsyncConnections.empty())
         return false;
 
     MANGOS_ASSERT(!m_currentTransaction.get());   // if we will get a nested transaction request - we MUST fix code!!!
 
     if (!m_currentTransaction.get())
-        m_currentTransaction.reset(new SqlTransaction);
+        m_currentTransaction.reset(new SqlTransaction(orderKey));
 
     return m_currentTransaction.get() != nullptr;
 }
 
 bool Database::CommitTransaction()
 {
-    if (!m_pAsyncConn || !m_currentTransaction.get())
+    if (m_pAsyncConnections.empty() || !m_currentTransaction.get())
         return false;
 
     // if async execution is not available
     if (!m_allowAsyncTransactions)
         return CommitTransactionDirect();
 
-    // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
-    return true;
+    // add SqlTransaction to the async queue of its order key
+    uint32 orderKey = m_currentTransaction->GetOrderKey();
+    return DelayRequest(m_currentTransaction.release(), orderKey);
 }
 
 bool Database::CommitTransactionDirect()
 {
-    if (!m_pAsyncConn)
+    if (m_pAsyncConnections.empty())
         return false;
 
     // check if we have pending transaction
@@ -424,7 +494,7 @@ bool Database::CommitTransactionDirect()
 
     // directly execute SqlTransaction
     auto const pTrans = m_currentTransaction.release();
-    pTrans->Execute(m_pAsyncConn);
+    pTrans->Execute(getAsyncConnection());
     delete pTrans;
 
     return true;
@@ -432,7 +502,7 @@ bool Database::CommitTransactionDirect()
 
 bool Database::RollbackTransaction()
 {
-    if (!m_pAsyncConn)
+    if (m_pAsyncConnections.empty())
         return false;
 
     if (!m_currentTransaction.get())
@@ -547,7 +617,7 @@ bool Database::CheckRequiredField(char const* table_name, char const* required_n
 
 bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
 {
-    if (!m_pAsyncConn)
+    if (m_pAsyncConnections.empty())
         return false;
 
     auto const pTrans = m_currentTransaction.get();
@@ -563,7 +633,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayRequest(new SqlPreparedRequest(id.ID(), params), 0);
     }
 
     return true;
@@ -28,6 +28,7 @@
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
+#include <functional>
 #include <memory>
 
 class SqlTransaction;
@@ -106,10 +107,10 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution, one per async connection
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -130,10 +131,10 @@ class Database
 
         bool DirectExecute(const char* sql) const
         {
-            if (!m_pAsyncConn)
+            if (m_pAsyncConnections.empty())
                 return false;
 
-            SqlConnection::Lock guard(m_pAsyncConn);
+            SqlConnection::Lock guard(getAsyncConnection());
             return guard->Execute(sql);
         }
 
@@ -178,14 +179,29 @@ class Database
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
         template<class Class, typename ParamType1>
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
+        // QueryHolder ordered with the transactions of the same order key, e.g. a character load behind its last save
+        template<class Class>
+        bool DelayQueryHolder(uint32 orderKey, Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
 
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        // Query / handler, the handler is called on the delay thread of the order key instead of through the result queue,
+        // for callers that resume on their own event loop. Requests with the same order key keep their order with transactions
+        typedef std::function<void(std::unique_ptr<QueryResult>)> QueryHandler;
+        bool AsyncQuery(uint32 orderKey, QueryHandler&& handler, const char* sql);
+        bool AsyncPQuery(uint32 orderKey, QueryHandler&& handler, const char* format, ...) ATTR_PRINTF(4, 5);
+
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
+        // transactions with the same order key are executed in order, different keys may run in parallel
+        // on separate async connections. Key 0, like every async request without a key, waits for all
+        // requests queued before it and all requests queued after it wait for it. Only keyed traffic gains
+        // from more async connections: character and pet saves, character login and deletion are keyed by the
+        // character guid, realmd login writes by the account. Plain Execute/PExecute and unkeyed transactions
+        // still run one at a time
+        bool BeginTransaction(uint32 orderKey = 0);
         bool CommitTransaction();
         bool RollbackTransaction();
         // for sync transaction execution
@@ -198,7 +214,7 @@ class Database
         // get prepared statement format string
         std::string GetStmtString(const int stmtId) const;
 
-        operator bool () const { return !m_pQueryConnections.empty() && m_pAsyncConn; }
+        operator bool () const { return !m_pQueryConnections.empty() && !m_pAsyncConnections.empty(); }
 
         // escape string generation
         void escape_string(std::string& str);
@@ -224,8 +240,7 @@ class Database
 
     protected:
         Database() :
-            m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_nQueryConnPoolSize(1), m_pResultQueue(nullptr), m_haltingDelayThreads(false), m_allowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -236,7 +251,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -245,8 +260,12 @@ class Database
 
         // round-robin connection selection
         SqlConnection* getQueryConnection();
-        // for now return one single connection for async requests
-        SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // connection used for direct execution, shared with the async requests of order key 0
+        SqlConnection* getAsyncConnection() const { return m_pAsyncConnections[0]; }
+        // delay thread which executes requests of the given order key
+        SqlDelayThread* getDelayThread(uint32 orderKey) const { return m_threadBodies[orderKey % m_threadBodies.size()]; }
+        // queue an async request, order key 0 is fenced against the requests of all keys
+        bool DelayRequest(SqlOperation* sql, uint32 orderKey);
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -262,12 +281,14 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
-        SqlConnection* m_pAsyncConn;
+        // one DB connection and delay thread per order key slot for transactions and async requests
+        SqlConnectionContainer m_pAsyncConnections;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads
+        std::mutex m_fenceLock;                             ///< Keeps fences in the same order in every delay queue
+        std::atomic<bool> m_haltingDelayThreads;            ///< Threads may be gone, fences could not complete
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
@@ -54,7 +54,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*), const c
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 template<class Class, typename ParamType1>
@@ -63,7 +63,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 template<class Class, typename ParamType1, typename ParamType2>
@@ -72,7 +72,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1, param2);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 template<class Class, typename ParamType1, typename ParamType2, typename ParamType3>
@@ -81,7 +81,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1, param2, param3);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 // -- Query / static --
@@ -92,7 +92,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1), ParamType1 param1
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 template<typename ParamType1, typename ParamType2>
@@ -101,7 +101,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2), Param
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1, param2);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 template<typename ParamType1, typename ParamType2, typename ParamType3>
@@ -110,7 +110,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamT
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1, param2, param3);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return DelayRequest(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
 }
 
 // -- PQuery / member --
@@ -179,9 +179,7 @@ template<class Class>
 bool
 Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder)
 {
-    ASYNC_DELAYHOLDER_BODY(holder)
-    auto callback = std::bind(method, object, std::placeholders::_1, holder);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return DelayQueryHolder(0, object, method, holder);
 }
 
 template<class Class, typename ParamType1>
@@ -190,7 +188,16 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, Sq
 {
     ASYNC_DELAYHOLDER_BODY(holder)
     auto callback = std::bind(method, object, std::placeholders::_1, holder, param1);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return DelayRequest(new SqlQueryHolderEx(holder, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), 0);
+}
+
+template<class Class>
+bool
+Database::DelayQueryHolder(uint32 orderKey, Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder)
+{
+    ASYNC_DELAYHOLDER_BODY(holder)
+    auto callback = std::bind(method, object, std::placeholders::_1, holder);
+    return DelayRequest(new SqlQueryHolderEx(holder, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue), orderKey);
 }
 
 #undef ASYNC_QUERY_BODY
@@ -18,6 +18,9 @@
 
 #include "SQLStorage.h"
 
+// string fields are stored in the snapshot as offsets into its string block, in place of the pointer
+static_assert(sizeof(uintptr_t) == sizeof(char*), "snapshot string offsets must fit the string pointer of a record");
+
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
 SQLStorageBase::SQLStorageBase() :
@@ -120,6 +123,160 @@ void SQLStorageBase::Free()
     m_recordCount = 0;
 }
 
+std::vector<uint32> SQLStorageBase::GetStringFieldOffsets() const
+{
+    std::vector<uint32> offsets;
+
+    uint32 offset = 0;
+    for (uint32 x = 0; x < m_dstFieldCount; ++x)
+    {
+        switch (m_dst_format[x])
+        {
+            case FT_LOGIC:
+                offset += sizeof(bool);
+                break;
+            case FT_STRING:
+            case FT_NA_POINTER:
+                offsets.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            case FT_NA:
+            case FT_INT:
+                offset += sizeof(uint32);
+                break;
+            case FT_BYTE:
+            case FT_NA_BYTE:
+                offset += sizeof(char);
+                break;
+            case FT_FLOAT:
+            case FT_NA_FLOAT:
+                offset += sizeof(float);
+                break;
+            case FT_64BITINT:
+                offset += sizeof(uint64);
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+    return offsets;
+}
+
+// Section layout: formats, record size, max entry, record count, then every record as [uint32 id][record]
+// with string pointers replaced by their offset + 1 in the string pool that follows the records (0 for null)
+bool SQLStorageBase::LoadFromSnapshot()
+{
+    char const* data;
+    size_t size;
+    if (!sWorldSnapshot.GetSection(std::string("storage:") + m_tableName, data, size))
+        return false;
+
+    auto read = [&data](void* dst, size_t length) { memcpy(dst, data, length); data += length; };
+
+    // the structures may have changed since the snapshot was taken
+    for (char const* format : { m_src_format, m_dst_format })
+    {
+        uint32 length;
+        read(&length, sizeof(length));
+        if (length != strlen(format) || memcmp(data, format, length) != 0)
+            return false;
+        data += length;
+    }
+
+    uint32 recordSize, maxEntry, recordCount;
+    read(&recordSize, sizeof(recordSize));
+    read(&maxEntry, sizeof(maxEntry));
+    read(&recordCount, sizeof(recordCount));
+
+    // empty table, same as the database loader nothing is touched
+    if (!recordCount)
+        return true;
+
+    prepareToLoad(maxEntry, recordCount, recordSize);
+
+    std::vector<uint32> const stringOffsets = GetStringFieldOffsets();
+    char const* strings = data + recordCount * (sizeof(uint32) + recordSize);
+
+    for (uint32 i = 0; i < recordCount; ++i)
+    {
+        uint32 recordId;
+        read(&recordId, sizeof(recordId));
+
+        char* record = createRecord(recordId);
+        read(record, recordSize);
+
+        for (uint32 offset : stringOffsets)
+        {
+            uintptr_t stringOffset;
+            memcpy(&stringOffset, record + offset, sizeof(stringOffset));
+
+            char* str = nullptr;
+            if (stringOffset)
+            {
+                char const* src = strings + stringOffset - 1;
+                uint32 length = strlen(src) + 1;
+                str = new char[length];
+                memcpy(str, src, length);
+            }
+            memcpy(record + offset, &str, sizeof(str));
+        }
+    }
+
+    return true;
+}
+
+void SQLStorageBase::SaveToSnapshot(std::vector<uint32> const& recordIds) const
+{
+    if (!sWorldSnapshot.IsActive())
+        return;
+
+    std::vector<char> buffer;
+    auto append = [&buffer](void const* src, size_t length) { buffer.insert(buffer.end(), static_cast<char const*>(src), static_cast<char const*>(src) + length); };
+
+    for (char const* format : { m_src_format, m_dst_format })
+    {
+        uint32 length = strlen(format);
+        append(&length, sizeof(length));
+        append(format, length);
+    }
+
+    uint32 recordCount = recordIds.size();
+    append(&m_recordSize, sizeof(m_recordSize));
+    append(&m_maxEntry, sizeof(m_maxEntry));
+    append(&recordCount, sizeof(recordCount));
+
+    std::vector<uint32> const stringOffsets = GetStringFieldOffsets();
+    std::vector<char> strings;
+    std::vector<char> record(m_recordSize);
+
+    for (uint32 i = 0; i < recordCount; ++i)
+    {
+        memcpy(record.data(), m_data + i * m_recordSize, m_recordSize);
+
+        for (uint32 offset : stringOffsets)
+        {
+            char const* str;
+            memcpy(&str, record.data() + offset, sizeof(str));
+
+            uintptr_t stringOffset = 0;
+            if (str)
+            {
+                stringOffset = strings.size() + 1;
+                strings.insert(strings.end(), str, str + strlen(str) + 1);
+            }
+            memcpy(record.data() + offset, &stringOffset, sizeof(stringOffset));
+        }
+
+        append(&recordIds[i], sizeof(uint32));
+        append(record.data(), m_recordSize);
+    }
+
+    append(strings.data(), strings.size());
+
+    sWorldSnapshot.AddSection(std::string("storage:") + m_tableName, std::move(buffer));
+}
+
 // -----------------------------------  SQLStorage  -------------------------------------------- //
 
 void SQLStorage::EraseEntry(uint32 id)
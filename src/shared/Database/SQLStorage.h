@@ -78,8 +78,13 @@ class SQLStorageBase
         virtual void JustCreatedRecord(uint32 recordId, char* record) = 0;
         virtual void Free();
 
+        // world snapshot support, records are stored as loaded and before any post processing
+        bool LoadFromSnapshot();
+        void SaveToSnapshot(std::vector<uint32> const& recordIds) const;
+
     private:
         char* createRecord(uint32 recordId);
+        std::vector<uint32> GetStringFieldOffsets() const;
 
         // Information about the table
         const char* m_tableName;
@@ -22,6 +22,7 @@
 #include "Util/ProgressBar.h"
 #include "Log/Log.h"
 #include "DBCFileLoader.h"
+#include "Database/WorldSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>                                  // S source-type, D destination-type
@@ -305,6 +306,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    if (store.LoadFromSnapshot())
+        return;
+
     Field* fields = nullptr;
     auto queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!queryResult)
@@ -319,6 +323,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     uint32 recordsize = 0;
 
     queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+    bool const counted = !!queryResult;
     if (queryResult)
     {
         fields = queryResult->Fetch();
@@ -334,6 +339,12 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         else
             sLog.outString("%s table is empty!\n", store.GetTableName());
 
+        // a failed query looks like an empty table, only an empty count tells them apart
+        if (counted && !recordCount)
+            store.SaveToSnapshot({});
+        else
+            sWorldSnapshot.Discard(store.GetTableName());
+
         recordCount = 0;
         return;
     }
@@ -385,6 +396,12 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    // record ids are only needed for the world snapshot
+    std::vector<uint32> recordIds;
+    bool const snapshot = sWorldSnapshot.IsActive();
+    if (snapshot)
+        recordIds.reserve(recordCount);
+
     BarGoLink bar(recordCount);
     do
     {
@@ -392,6 +409,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
+        if (snapshot)
+            recordIds.push_back(fields[0].GetUInt32());
         offset = 0;
 
         // dependend on dest-size
@@ -440,6 +459,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         }
     }
     while (queryResult->NextRow());
+
+    if (snapshot)
+        store.SaveToSnapshot(recordIds);
 }
 
 #endif
@@ -20,7 +20,10 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <algorithm>
+#include <chrono>
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_dbEngine(db), m_dbConnection(conn), m_pingDatabase(pingDatabase), m_running(true)
 {
 }
 
@@ -38,23 +41,26 @@ void SqlDelayThread::run()
 #endif
 #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    const std::chrono::milliseconds pingInterval(std::max<uint32>(m_dbEngine->GetPingIntervall(), 10));
+    auto nextPing = std::chrono::steady_clock::now() + pingInterval;
 
-    uint32 loopCounter = 0;
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
+        // sleep until there is work, a stop request or the next ping is due
+        // if the running state gets turned off while waiting
         // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait_until(lock, nextPing, [&]() { return !m_sqlQueue.empty() || !m_running; });
+        }
 
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (std::chrono::steady_clock::now() >= nextPing)
         {
-            loopCounter = 0;
-            m_dbEngine->Ping();
+            nextPing = std::chrono::steady_clock::now() + pingInterval;
+            if (m_pingDatabase)
+                m_dbEngine->Ping();
         }
     }
 
@@ -67,7 +73,11 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_all();
 }
 
 void SqlDelayThread::ProcessRequests()
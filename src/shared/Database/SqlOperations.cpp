@@ -82,6 +82,31 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+bool SqlFence::Execute(SqlConnection* conn)
+{
+    std::unique_lock<std::mutex> lock(m_state->lock);
+
+    if (!m_executes)
+    {
+        if (--m_state->waiting == 0)
+            m_state->condition.notify_all();
+
+        m_state->condition.wait(lock, [this]() { return m_state->done; });
+        return true;
+    }
+
+    /// everything queued before the request on the other connections is done now
+    m_state->condition.wait(lock, [this]() { return m_state->waiting == 0; });
+    lock.unlock();
+
+    bool result = m_state->request->Execute(conn);
+
+    lock.lock();
+    m_state->done = true;
+    m_state->condition.notify_all();
+    return result;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection* conn)
@@ -98,6 +123,19 @@ bool SqlQuery::Execute(SqlConnection* conn)
     return true;
 }
 
+bool SqlHandlerQuery::Execute(SqlConnection* conn)
+{
+    std::unique_ptr<QueryResult> queryResult;
+    {
+        LOCK_DB_CONN(conn);
+        queryResult = conn->Query(&m_sql[0]);
+    }
+
+    /// no result queue to go through, the handler hands the result on to its own thread
+    m_handler(std::move(queryResult));
+    return true;
+}
+
 void SqlResultQueue::Update()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
@@ -117,18 +155,6 @@ void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback)
     m_queue.push(std::unique_ptr<MaNGOS::IQueryCallback>(callback));
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
-{
-    if (!callback || !thread || !queue)
-        return false;
-
-    /// delay the execution of the queries, sync them with the delay thread
-    /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
-    return true;
-}
-
 bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
 {
     if (m_queries.size() <= index)
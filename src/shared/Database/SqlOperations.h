@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Utilities/Callback.h"
 
+#include <condition_variable>
+#include <functional>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -58,11 +60,14 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        uint32 m_orderKey;
 
     public:
-        SqlTransaction() {}
+        SqlTransaction(uint32 orderKey = 0) : m_orderKey(orderKey) {}
         ~SqlTransaction();
 
+        uint32 GetOrderKey() const { return m_orderKey; }
+
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
 
         bool Execute(SqlConnection* conn) override;
@@ -81,6 +86,31 @@ class SqlPreparedRequest : public SqlOperation
         SqlStmtParameters* m_param;
 };
 
+/// request without order key while several delay threads run: each thread gets a fence in its queue, the first
+/// thread executes the request once all others reached theirs and they only continue after it is done
+class SqlFence : public SqlOperation
+{
+    public:
+        struct State
+        {
+            State(SqlOperation* sql, size_t others) : request(sql), waiting(others), done(false) {}
+
+            std::mutex lock;
+            std::condition_variable condition;
+            std::unique_ptr<SqlOperation> request;
+            size_t waiting;                                 ///< threads that did not reach their fence yet
+            bool done;
+        };
+
+        SqlFence(std::shared_ptr<State> state, bool executes) : m_state(std::move(state)), m_executes(executes) {}
+
+        bool Execute(SqlConnection* conn) override;
+
+    private:
+        std::shared_ptr<State> m_state;
+        bool m_executes;
+};
+
 /// ---- ASYNC QUERIES ----
 
 class SqlQuery;                                             /// contains a single async query
@@ -116,6 +146,22 @@ class SqlQuery : public SqlOperation
         bool Execute(SqlConnection* conn) override;
 };
 
+class SqlHandlerQuery : public SqlOperation
+{
+    private:
+        std::vector<char> m_sql;
+        std::function<void(std::unique_ptr<QueryResult>)> m_handler;
+
+    public:
+        SqlHandlerQuery(const char* sql, std::function<void(std::unique_ptr<QueryResult>)>&& handler)
+            : m_sql(strlen(sql) + 1), m_handler(std::move(handler))
+        {
+            memcpy(&m_sql[0], sql, m_sql.size());
+        }
+
+        bool Execute(SqlConnection* conn) override;
+};
+
 class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
@@ -130,7 +176,6 @@ class SqlQueryHolder
         void SetSize(size_t size);
         std::unique_ptr<QueryResult> GetResult(size_t index);
         void SetResult(size_t index, std::unique_ptr<QueryResult> queryResult);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
 };
 
 class SqlQueryHolderEx : public SqlOperation
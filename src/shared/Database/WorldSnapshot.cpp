@@ -0,0 +1,473 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Database/WorldSnapshot.h"
+#include "Database/Database.h"
+#include "Auth/CryptoHash.h"
+#include "Log/Log.h"
+
+#include <cstdarg>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+INSTANTIATE_SINGLETON_1(WorldSnapshot);
+
+/*
+ * File layout, all integers in host byte order:
+ *   header: magic, format version, pointer size, revision, section count, body size, sha1 of the body
+ *   body:   directory (name, offset in body, size) for every section, followed by the section data
+ *
+ * Query sections hold the field count, row count and field types followed by every row as
+ * [uint32 length or SNAPSHOT_NULL_FIELD][bytes]['\0'], so that Field can point into the mapping.
+ */
+#define SNAPSHOT_MAGIC          "WSNP"
+#define SNAPSHOT_VERSION        1
+#define SNAPSHOT_NULL_FIELD     0xFFFFFFFF
+
+namespace
+{
+template<class T>
+T ReadValue(char const*& pos)
+{
+    T value;
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+template<class T>
+void AppendValue(std::vector<char>& buffer, T value)
+{
+    char const* bytes = reinterpret_cast<char const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendString(std::vector<char>& buffer, std::string const& str)
+{
+    AppendValue<uint32>(buffer, str.length());
+    buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+class SnapshotQueryResult : public QueryResult
+{
+    public:
+        SnapshotQueryResult(char const* rows, char const* end, uint64 rowCount, uint32 fieldCount, char const* types)
+            : QueryResult(rowCount, fieldCount), m_pos(rows), m_end(end), m_fields(new Field[fieldCount])
+        {
+            for (uint32 i = 0; i < fieldCount; ++i)
+                m_fields[i].SetType(Field::DataTypes(types[i]));
+
+            mCurrentRow = m_fields.get();
+            NextRow();
+        }
+
+        bool NextRow() override
+        {
+            if (m_pos >= m_end)
+                return false;
+
+            for (uint32 i = 0; i < mFieldCount; ++i)
+            {
+                uint32 length = ReadValue<uint32>(m_pos);
+                if (length == SNAPSHOT_NULL_FIELD)
+                {
+                    m_fields[i].SetValue(nullptr);
+                    continue;
+                }
+
+                m_fields[i].SetValue(m_pos);
+                m_pos += length + 1;
+            }
+            return true;
+        }
+
+    private:
+        char const* m_pos;
+        char const* m_end;
+        std::unique_ptr<Field[]> m_fields;
+};
+
+std::vector<char> SerializeResult(QueryResult* result)
+{
+    std::vector<char> buffer;
+
+    uint32 fieldCount = result ? result->GetFieldCount() : 0;
+    uint64 rowCount = result ? result->GetRowCount() : 0;
+    AppendValue<uint32>(buffer, fieldCount);
+    AppendValue<uint64>(buffer, rowCount);
+
+    if (!result)
+        return buffer;
+
+    Field* fields = result->Fetch();
+    for (uint32 i = 0; i < fieldCount; ++i)
+        AppendValue<uint8>(buffer, fields[i].GetType());
+
+    do
+    {
+        fields = result->Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            if (fields[i].IsNULL())
+            {
+                AppendValue<uint32>(buffer, SNAPSHOT_NULL_FIELD);
+                continue;
+            }
+
+            char const* value = fields[i].GetString();
+            size_t length = strlen(value);
+            AppendValue<uint32>(buffer, length);
+            buffer.insert(buffer.end(), value, value + length + 1);
+        }
+    }
+    while (result->NextRow());
+
+    return buffer;
+}
+
+std::unique_ptr<QueryResult> DeserializeResult(char const* data, size_t size)
+{
+    char const* pos = data;
+    uint32 fieldCount = ReadValue<uint32>(pos);
+    uint64 rowCount = ReadValue<uint64>(pos);
+
+    // same as the database, empty results are returned as null
+    if (!rowCount)
+        return nullptr;
+
+    char const* types = pos;
+    pos += fieldCount;
+
+    return std::make_unique<SnapshotQueryResult>(pos, data + size, rowCount, fieldCount, types);
+}
+
+// the database returns null for failed queries as well as for empty results, EXISTS only succeeds for a valid query
+bool IsEmptyResult(Database& db, char const* sql)
+{
+    auto existsResult = db.PQuery("SELECT CASE WHEN EXISTS(%s) THEN 1 ELSE 0 END", sql);
+    return existsResult && (*existsResult)[0].GetUInt32() == 0;
+}
+}
+
+WorldSnapshot::WorldSnapshot() : m_active(false), m_dirty(false), m_invalidated(false), m_failed(false) {}
+
+WorldSnapshot::~WorldSnapshot() {}
+
+void WorldSnapshot::Open(std::string const& filename, std::string const& revision)
+{
+    m_filename = filename;
+    m_revision = revision;
+    m_active = true;
+    m_dirty = false;
+    m_failed = false;
+
+    if (Map(revision))
+    {
+        sLog.outString("World snapshot: using %s (%u sections)", m_filename.c_str(), uint32(m_mapped.size()));
+        return;
+    }
+
+    sLog.outString("World snapshot: %s is missing or outdated, loading from the database and recording a new one", m_filename.c_str());
+    m_mapped.clear();
+    m_region = boost::interprocess::mapped_region();
+    m_file = boost::interprocess::file_mapping();
+    m_dirty = true;
+}
+
+bool WorldSnapshot::Map(std::string const& revision)
+{
+    if (!std::filesystem::exists(m_filename))
+        return false;
+
+    try
+    {
+        m_file = boost::interprocess::file_mapping(m_filename.c_str(), boost::interprocess::read_only);
+        m_region = boost::interprocess::mapped_region(m_file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        sLog.outError("World snapshot: can't map %s: %s", m_filename.c_str(), e.what());
+        return false;
+    }
+
+    char const* begin = static_cast<char const*>(m_region.get_address());
+    char const* end = begin + m_region.get_size();
+    char const* pos = begin;
+
+    auto available = [&](size_t size) { return size_t(end - pos) >= size; };
+
+    if (!available(4 + 4 * sizeof(uint32)) || memcmp(pos, SNAPSHOT_MAGIC, 4) != 0)
+        return false;
+    pos += 4;
+
+    if (ReadValue<uint32>(pos) != SNAPSHOT_VERSION || ReadValue<uint32>(pos) != sizeof(char*))
+        return false;
+
+    uint32 revisionLength = ReadValue<uint32>(pos);
+    if (!available(revisionLength) || std::string(pos, revisionLength) != revision)
+        return false;
+    pos += revisionLength;
+
+    if (!available(sizeof(uint32) + sizeof(uint64) + Sha1Hash::GetLength()))
+        return false;
+
+    uint32 sectionCount = ReadValue<uint32>(pos);
+    uint64 bodySize = ReadValue<uint64>(pos);
+    char const* digest = pos;
+    pos += Sha1Hash::GetLength();
+
+    if (uint64(end - pos) != bodySize)
+        return false;
+
+    // the body is hashed in chunks, UpdateData takes an int
+    Sha1Hash hash;
+    for (char const* chunk = pos; chunk < end; chunk += std::min<size_t>(end - chunk, 1 << 30))
+        hash.UpdateData(reinterpret_cast<uint8 const*>(chunk), std::min<size_t>(end - chunk, 1 << 30));
+    hash.Finalize();
+
+    if (memcmp(hash.GetDigest(), digest, Sha1Hash::GetLength()) != 0)
+    {
+        sLog.outError("World snapshot: checksum mismatch in %s", m_filename.c_str());
+        return false;
+    }
+
+    char const* body = pos;
+    for (uint32 i = 0; i < sectionCount; ++i)
+    {
+        if (!available(sizeof(uint32)))
+            return false;
+
+        uint32 nameLength = ReadValue<uint32>(pos);
+        if (!available(nameLength + 2 * sizeof(uint64)))
+            return false;
+
+        std::string name(pos, nameLength);
+        pos += nameLength;
+
+        uint64 offset = ReadValue<uint64>(pos);
+        uint64 size = ReadValue<uint64>(pos);
+        if (offset > bodySize || size > bodySize - offset)
+            return false;
+
+        m_mapped[name] = { body + offset, size_t(size) };
+    }
+
+    return true;
+}
+
+bool WorldSnapshot::Write() const
+{
+    std::string const tempName = m_filename + ".tmp";
+    std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        sLog.outError("World snapshot: can't create %s", tempName.c_str());
+        return false;
+    }
+
+    // mapped sections which were not requested during this startup belong to queries which no longer exist
+    std::vector<std::pair<std::string, Section>> sections;
+    for (auto const& name : m_used)
+        if (!m_recorded.count(name))
+            sections.emplace_back(name, m_mapped.at(name));
+    for (auto const& recorded : m_recorded)
+        sections.emplace_back(recorded.first, Section{ recorded.second->data(), recorded.second->size() });
+
+    std::vector<char> directory;
+    uint64 directorySize = 0;
+    for (auto const& section : sections)
+        directorySize += sizeof(uint32) + section.first.length() + 2 * sizeof(uint64);
+
+    uint64 offset = directorySize;
+    for (auto const& section : sections)
+    {
+        AppendString(directory, section.first);
+        AppendValue<uint64>(directory, offset);
+        AppendValue<uint64>(directory, section.second.size);
+        offset += section.second.size;
+    }
+
+    Sha1Hash hash;
+    hash.UpdateData(reinterpret_cast<uint8 const*>(directory.data()), directory.size());
+    for (auto const& section : sections)
+        for (size_t done = 0; done < section.second.size; done += std::min<size_t>(section.second.size - done, 1 << 30))
+            hash.UpdateData(reinterpret_cast<uint8 const*>(section.second.data + done), std::min<size_t>(section.second.size - done, 1 << 30));
+    hash.Finalize();
+
+    std::vector<char> header(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4);
+    AppendValue<uint32>(header, SNAPSHOT_VERSION);
+    AppendValue<uint32>(header, sizeof(char*));
+    AppendString(header, m_revision);
+    AppendValue<uint32>(header, sections.size());
+    AppendValue<uint64>(header, offset);
+    header.insert(header.end(), hash.GetDigest(), hash.GetDigest() + Sha1Hash::GetLength());
+
+    file.write(header.data(), header.size());
+    file.write(directory.data(), directory.size());
+    for (auto const& section : sections)
+        file.write(section.second.data, section.second.size);
+
+    if (!file.good())
+    {
+        sLog.outError("World snapshot: failed writing %s", tempName.c_str());
+        return false;
+    }
+
+    sLog.outString("World snapshot: recorded %u sections (%u new) into %s", uint32(sections.size()), uint32(m_recorded.size()), m_filename.c_str());
+    return true;
+}
+
+void WorldSnapshot::Close()
+{
+    if (!m_active)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    bool written = m_dirty && !m_failed && !m_invalidated && Write();
+
+    // the old file has to be unmapped before it can be replaced
+    m_mapped.clear();
+    m_region = boost::interprocess::mapped_region();
+    m_file = boost::interprocess::file_mapping();
+
+    if (written)
+    {
+        std::error_code error;
+        std::filesystem::rename(m_filename + ".tmp", m_filename, error);
+        if (error)
+            sLog.outError("World snapshot: can't replace %s: %s", m_filename.c_str(), error.message().c_str());
+    }
+
+    m_used.clear();
+    m_recorded.clear();
+    m_active = false;
+}
+
+void WorldSnapshot::Discard(char const* what)
+{
+    if (!m_active)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_failed)
+        sLog.outError("World snapshot: loading %s failed, %s will not be saved", what, m_filename.c_str());
+    m_failed = true;
+}
+
+void WorldSnapshot::Invalidate()
+{
+    // only the first change has to remove the file
+    if (m_filename.empty() || m_invalidated.exchange(true))
+        return;
+
+    std::error_code error;
+    std::filesystem::remove(m_filename, error);
+    if (error)
+        sLog.outError("World snapshot: world tables changed but %s can't be removed: %s", m_filename.c_str(), error.message().c_str());
+    else
+        sLog.outString("World snapshot: world tables changed, removed %s", m_filename.c_str());
+}
+
+bool WorldSnapshot::GetSection(std::string const& name, char const*& data, size_t& size)
+{
+    if (!m_active)
+        return false;
+
+    auto itr = m_mapped.find(name);
+    if (itr == m_mapped.end())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_used.insert(name);
+    }
+
+    data = itr->second.data;
+    size = itr->second.size;
+    return true;
+}
+
+void WorldSnapshot::AddSection(std::string const& name, std::vector<char>&& data)
+{
+    if (!m_active)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_recorded[name] = std::make_unique<std::vector<char>>(std::move(data));
+    m_dirty = true;
+}
+
+std::unique_ptr<QueryResult> WorldSnapshot::Query(Database& db, char const* sql)
+{
+    if (!m_active)
+        return db.Query(sql);
+
+    std::string const name = std::string("query:") + sql;
+
+    char const* data;
+    size_t size;
+    if (GetSection(name, data, size))
+        return DeserializeResult(data, size);
+
+    // a query repeated during this startup is served from the copy recorded the first time
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto itr = m_recorded.find(name);
+        if (itr != m_recorded.end())
+            return DeserializeResult(itr->second->data(), itr->second->size());
+    }
+
+    auto queryResult = db.Query(sql);
+    if (!queryResult && !IsEmptyResult(db, sql))
+    {
+        Discard(sql);
+        return nullptr;
+    }
+
+    // the recorded copy is handed out as well, so that the caller sees exactly what the next startup will see
+    auto buffer = std::make_unique<std::vector<char>>(SerializeResult(queryResult.get()));
+    data = buffer->data();
+    size = buffer->size();
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_recorded[name] = std::move(buffer);
+        m_dirty = true;
+    }
+
+    return DeserializeResult(data, size);
+}
+
+std::unique_ptr<QueryResult> WorldSnapshot::PQuery(Database& db, char const* format, ...)
+{
+    va_list ap;
+    char szQuery[MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return {};
+    }
+
+    return Query(db, szQuery);
+}
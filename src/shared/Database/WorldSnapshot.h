@@ -0,0 +1,104 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Database/QueryResult.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class Database;
+
+/**
+ * Binary copy of immutable world database content, used to skip the database at startup.
+ *
+ * The file holds named sections: raw SQLStorage records and the result sets of whitelisted
+ * startup queries. It is tied to the world database revision and checksummed, a mismatch on
+ * either makes the server load from the database as usual. Anything that had to be loaded from
+ * the database is recorded and a new file is written by Close(), unless loading any of it failed.
+ *
+ * Only active between Open() and Close() at startup, later reloads always use the database.
+ * Runtime changes of the recorded tables have to call Invalidate().
+ */
+class WorldSnapshot
+{
+    public:
+        WorldSnapshot();
+        ~WorldSnapshot();
+
+        /// Maps the file when it matches revision, otherwise starts recording a new one
+        void Open(std::string const& filename, std::string const& revision);
+        /// Writes the file again if any section was missing, then releases the mapping
+        void Close();
+
+        bool IsActive() const { return m_active; }
+
+        /// A recorded table failed to load, no file is written by Close() for this startup
+        void Discard(char const* what);
+        /// A recorded table was changed, removes the file so that the next startup loads from the database
+        void Invalidate();
+
+        /// Cached Database::Query for queries which only depend on world database content
+        std::unique_ptr<QueryResult> Query(Database& db, char const* sql);
+        std::unique_ptr<QueryResult> PQuery(Database& db, char const* format, ...) ATTR_PRINTF(3, 4);
+
+        /// Raw section access, data stays valid until Close()
+        bool GetSection(std::string const& name, char const*& data, size_t& size);
+        void AddSection(std::string const& name, std::vector<char>&& data);
+
+    private:
+        struct Section
+        {
+            char const* data;
+            size_t size;
+        };
+
+        bool Map(std::string const& revision);
+        bool Write() const;
+
+        bool m_active;
+        bool m_dirty;
+        std::atomic<bool> m_invalidated;
+        std::string m_filename;
+        std::string m_revision;
+
+        boost::interprocess::file_mapping m_file;
+        boost::interprocess::mapped_region m_region;
+        std::unordered_map<std::string, Section> m_mapped;      // read only after Open()
+
+        std::mutex m_lock;                                      // guards everything below
+        bool m_failed;
+        std::set<std::string> m_used;                           // mapped sections requested during this startup
+        std::map<std::string, std::unique_ptr<std::vector<char>>> m_recorded;
+};
+
+#define sWorldSnapshot MaNGOS::Singleton<WorldSnapshot>::Instance()
+
+#endif
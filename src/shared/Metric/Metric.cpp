@@ -169,6 +169,62 @@ void metric::metric::report(std::string measurement, std::map<std::string, boost
     });
 }
 
+std::shared_ptr<metric::counter> metric::metric::register_counter(std::string const& name, std::map<std::string, std::string> const& tags)
+{
+    auto result = std::make_shared<counter>(name, tags);
+
+    std::lock_guard<std::mutex> guard(m_seriesLock);
+    m_series.push_back(result);
+    return result;
+}
+
+std::shared_ptr<metric::gauge> metric::metric::register_gauge(std::string const& name, std::map<std::string, std::string> const& tags)
+{
+    auto result = std::make_shared<gauge>(name, tags);
+
+    std::lock_guard<std::mutex> guard(m_seriesLock);
+    m_series.push_back(result);
+    return result;
+}
+
+std::shared_ptr<metric::histogram> metric::metric::register_histogram(std::string const& name, std::map<std::string, std::string> const& tags, std::vector<int64> const& bounds)
+{
+    auto result = std::make_shared<histogram>(name, tags, bounds);
+
+    std::lock_guard<std::mutex> guard(m_seriesLock);
+    m_series.push_back(result);
+    return result;
+}
+
+void metric::metric::serialize_series(std::string& out)
+{
+    auto now = std::chrono::system_clock::now();
+    uint64 timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> guard(m_seriesLock);
+
+    // released before the previous flush started, anything their owner added is in that flush or this one
+    for (auto const& released : m_releasedSeries)
+        released->serialize(out, timestamp);
+    m_releasedSeries.clear();
+
+    for (auto itr = m_series.begin(); itr != m_series.end();)
+    {
+        // checked before serializing, an owner letting go afterwards may still have added values since then
+        bool ownerGone = itr->use_count() == 1;
+
+        (*itr)->serialize(out, timestamp);
+
+        if (ownerGone)
+        {
+            m_releasedSeries.push_back(std::move(*itr));
+            itr = m_series.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
 void metric::metric::schedule_timer()
 {
     using namespace std::placeholders;
@@ -204,6 +260,9 @@ void metric::metric::send()
         std::swap(measurements, m_measurementQueue);
     }
 
+    m_seriesBuffer.clear();
+    serialize_series(m_seriesBuffer);
+
     sLog.outDetail("Sending %zu measurements!", measurements.size());
 
     using boost::asio::ip::tcp;
@@ -247,6 +306,14 @@ void metric::metric::send()
         payload << *measurement;
     }
 
+    if (!m_seriesBuffer.empty())
+    {
+        if (!measurements.empty())
+            payload << "\n";
+
+        payload << m_seriesBuffer;
+    }
+
     boost::asio::streambuf request;
     std::ostream request_stream(&request);
 
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "Measurement.h"
+#include "Series.h"
 #include "Common.h"
 
 struct MetricConnectionInfo
@@ -105,6 +106,46 @@ namespace metric
             std::chrono::high_resolution_clock::time_point m_startTime;
     };
 
+    struct no_fields
+    {
+        std::map<std::string, boost::any> operator()() const { return {}; }
+    };
+
+    // Like duration with a threshold, but tags and extra fields are only built once the threshold is reached,
+    // so the common fast case does not allocate. Use make_threshold_duration to create one.
+    template <class precision, class TagsBuilder, class FieldsBuilder = no_fields>
+    class threshold_duration
+    {
+        public:
+            threshold_duration(char const* name, int64 threshold, TagsBuilder tags, FieldsBuilder fields = FieldsBuilder())
+                : m_name(name), m_threshold(threshold), m_tags(std::move(tags)), m_fields(std::move(fields)), m_startTime(std::chrono::high_resolution_clock::now())
+            {}
+
+            ~threshold_duration();
+
+            threshold_duration(threshold_duration const&) = delete;
+            threshold_duration& operator=(threshold_duration const&) = delete;
+
+        private:
+            char const* m_name;
+            int64 m_threshold;
+            TagsBuilder m_tags;
+            FieldsBuilder m_fields;
+            std::chrono::high_resolution_clock::time_point m_startTime;
+    };
+
+    template <class precision, class TagsBuilder>
+    threshold_duration<precision, TagsBuilder> make_threshold_duration(char const* name, int64 threshold, TagsBuilder tags)
+    {
+        return threshold_duration<precision, TagsBuilder>(name, threshold, std::move(tags));
+    }
+
+    template <class precision, class TagsBuilder, class FieldsBuilder>
+    threshold_duration<precision, TagsBuilder, FieldsBuilder> make_threshold_duration(char const* name, int64 threshold, TagsBuilder tags, FieldsBuilder fields)
+    {
+        return threshold_duration<precision, TagsBuilder, FieldsBuilder>(name, threshold, std::move(tags), std::move(fields));
+    }
+
     class metric
     {
         public:
@@ -119,6 +160,11 @@ namespace metric
             void report(std::string measurement, std::string key, boost::any value, std::map<std::string, std::string> tags = {});
             void report(std::string measurement, std::map<std::string, boost::any> fields, std::map<std::string, std::string> tags = {});
 
+            // preregistered series, safe to update from any thread; keep the returned pointer and drop it when the series is no longer needed
+            std::shared_ptr<counter> register_counter(std::string const& name, std::map<std::string, std::string> const& tags = {});
+            std::shared_ptr<gauge> register_gauge(std::string const& name, std::map<std::string, std::string> const& tags = {});
+            std::shared_ptr<histogram> register_histogram(std::string const& name, std::map<std::string, std::string> const& tags, std::vector<int64> const& bounds);
+
         private:
             boost::asio::io_context m_queueContext;
             boost::asio::io_context m_writeContext;
@@ -135,10 +181,30 @@ namespace metric
             std::mutex m_queueWriteLock;
             std::vector<std::unique_ptr<Measurement>> m_measurementQueue;
 
+            std::mutex m_seriesLock;
+            std::vector<std::shared_ptr<series>> m_series;
+            std::vector<std::shared_ptr<series>> m_releasedSeries; // owner was gone before the last flush, reported once more
+            std::string m_seriesBuffer;                     // reused between flushes
+
+            void serialize_series(std::string& out);
             void schedule_timer();
             void prepare_send(const boost::system::error_code& ec);
             void send();
     };
+
+    template <class precision, class TagsBuilder, class FieldsBuilder>
+    threshold_duration<precision, TagsBuilder, FieldsBuilder>::~threshold_duration()
+    {
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = static_cast<int64>(std::chrono::duration_cast<precision>(endTime - m_startTime).count());
+
+        if (duration < m_threshold)
+            return;
+
+        std::map<std::string, boost::any> fields = m_fields();
+        fields.emplace("duration", duration);
+        metric::instance().report(m_name, std::move(fields), m_tags());
+    }
 }
 
 #endif // MANGOSSERVER_METRIC_H
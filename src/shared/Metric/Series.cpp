@@ -0,0 +1,127 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <charconv>
+
+#include "Series.h"
+
+uint32 metric::detail::thread_slot()
+{
+    static std::atomic<uint32> nextSlot{0};
+    thread_local uint32 slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT;
+    return slot;
+}
+
+metric::series::series(std::string const& name, std::map<std::string, std::string> const& tags)
+    : m_prefix(name)
+{
+    for (auto const& tag : tags)
+        m_prefix.append(",").append(tag.first).append("=").append(tag.second);
+
+    m_prefix.append(" ");
+}
+
+void metric::series::append_field(std::string& out, std::string const& key, int64 value, bool first)
+{
+    char buffer[24];
+    auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+
+    if (!first)
+        out.push_back(',');
+    out.append(key).push_back('=');
+    out.append(buffer, result.ptr).push_back('i');
+}
+
+void metric::series::end_line(std::string& out, uint64 timestamp)
+{
+    char buffer[24];
+    auto result = std::to_chars(std::begin(buffer), std::end(buffer), timestamp);
+
+    out.push_back(' ');
+    out.append(buffer, result.ptr).push_back('\n');
+}
+
+void metric::counter::serialize(std::string& out, uint64 timestamp)
+{
+    int64 total = 0;
+    for (auto& slot : m_slots)
+        total += slot.value.exchange(0, std::memory_order_relaxed);
+
+    static const std::string key = "value";
+
+    begin_line(out);
+    append_field(out, key, total, true);
+    end_line(out, timestamp);
+}
+
+void metric::gauge::serialize(std::string& out, uint64 timestamp)
+{
+    static const std::string key = "value";
+
+    begin_line(out);
+    append_field(out, key, m_value.load(std::memory_order_relaxed), true);
+    end_line(out, timestamp);
+}
+
+metric::histogram::histogram(std::string const& name, std::map<std::string, std::string> const& tags, std::vector<int64> const& bounds)
+    : series(name, tags), m_bounds(bounds), m_buckets(new std::atomic<int64>[bounds.size() + 1])
+{
+    for (int64 bound : m_bounds)
+        m_bucketKeys.push_back("le_" + std::to_string(bound));
+    m_bucketKeys.push_back("le_inf");
+
+    for (size_t i = 0; i <= m_bounds.size(); ++i)
+        m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void metric::histogram::record(int64 value)
+{
+    size_t bucket = 0;
+    while (bucket < m_bounds.size() && value > m_bounds[bucket])
+        ++bucket;
+
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    int64 max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+}
+
+void metric::histogram::serialize(std::string& out, uint64 timestamp)
+{
+    int64 count = m_count.exchange(0, std::memory_order_relaxed);
+    int64 sum = m_sum.exchange(0, std::memory_order_relaxed);
+    int64 max = m_max.exchange(0, std::memory_order_relaxed);
+
+    // nothing recorded since the last flush, do not report an empty distribution
+    if (!count)
+        return;
+
+    static const std::string countKey = "count";
+    static const std::string sumKey = "sum";
+    static const std::string maxKey = "max";
+
+    begin_line(out);
+    append_field(out, countKey, count, true);
+    append_field(out, sumKey, sum, false);
+    append_field(out, maxKey, max, false);
+    for (size_t i = 0; i <= m_bounds.size(); ++i)
+        append_field(out, m_bucketKeys[i], m_buckets[i].exchange(0, std::memory_order_relaxed), false);
+    end_line(out, timestamp);
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_METRIC_SERIES_H
+#define MANGOSSERVER_METRIC_SERIES_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+namespace metric
+{
+    namespace detail
+    {
+        constexpr uint32 SLOT_COUNT = 16;
+
+        // one cache line per slot so that writers on different threads never contend
+        struct alignas(64) slot_value
+        {
+            std::atomic<int64> value{0};
+        };
+
+        // stable per thread, assigned round robin on first use
+        uint32 thread_slot();
+    }
+
+    // Series are registered once with a fixed tag set and updated without any allocation.
+    // The registry owns them until the last outside reference is dropped, and serializes them
+    // to Influx line protocol on the metric write thread.
+    class series
+    {
+        public:
+            series(std::string const& name, std::map<std::string, std::string> const& tags);
+            virtual ~series() = default;
+
+            series(series const&) = delete;
+            series& operator=(series const&) = delete;
+
+            // appends one line for the values accumulated since the previous call, if any
+            virtual void serialize(std::string& out, uint64 timestamp) = 0;
+
+        protected:
+            void begin_line(std::string& out) const { out.append(m_prefix); }
+            static void append_field(std::string& out, std::string const& key, int64 value, bool first);
+            static void end_line(std::string& out, uint64 timestamp);
+
+        private:
+            std::string m_prefix;                           // "name,tag=value,... "
+    };
+
+    // monotonic count, reported as the delta since the previous flush
+    class counter final : public series
+    {
+        public:
+            using series::series;
+
+            void add(int64 value = 1) { m_slots[detail::thread_slot()].value.fetch_add(value, std::memory_order_relaxed); }
+
+            void serialize(std::string& out, uint64 timestamp) override;
+
+        private:
+            detail::slot_value m_slots[detail::SLOT_COUNT];
+    };
+
+    // last set value
+    class gauge final : public series
+    {
+        public:
+            using series::series;
+
+            void set(int64 value) { m_value.store(value, std::memory_order_relaxed); }
+            void add(int64 value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+            void serialize(std::string& out, uint64 timestamp) override;
+
+        private:
+            std::atomic<int64> m_value{0};
+    };
+
+    // distribution over fixed upper bounds, reset at each flush
+    // meant for values recorded by one thread at a time (eg. a map update), so it is not striped
+    class histogram final : public series
+    {
+        public:
+            histogram(std::string const& name, std::map<std::string, std::string> const& tags, std::vector<int64> const& bounds);
+
+            void record(int64 value);
+
+            void serialize(std::string& out, uint64 timestamp) override;
+
+        private:
+            std::vector<int64> m_bounds;                    // ascending upper bounds, last bucket is unbounded
+            std::vector<std::string> m_bucketKeys;
+            std::unique_ptr<std::atomic<int64>[]> m_buckets;
+            std::atomic<int64> m_count{0};
+            std::atomic<int64> m_sum{0};
+            std::atomic<int64> m_max{0};
+    };
+
+    // records the lifetime of the scope into a histogram
+    template <class precision>
+    class timer
+    {
+        public:
+            explicit timer(histogram* target) : m_target(target), m_startTime(std::chrono::steady_clock::now()) {}
+            ~timer()
+            {
+                if (m_target)
+                    m_target->record(std::chrono::duration_cast<precision>(std::chrono::steady_clock::now() - m_startTime).count());
+            }
+
+            timer(timer const&) = delete;
+            timer& operator=(timer const&) = delete;
+
+        private:
+            histogram* m_target;
+            std::chrono::steady_clock::time_point m_startTime;
+    };
+}
+
+#endif // MANGOSSERVER_METRIC_SERIES_H
@@ -0,0 +1,106 @@
+/*
+* This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MANGOSSERVER_ASYNC_CONTEXT_POOL
+#define MANGOSSERVER_ASYNC_CONTEXT_POOL
+
+#include "Platform/Define.h"
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace MaNGOS
+{
+    // one io_context per network thread, a socket stays on the shard it was accepted on for its whole lifetime
+    class AsyncContextPool
+    {
+        public:
+            struct Shard
+            {
+                Shard() : work(boost::asio::make_work_guard(context)), connections(std::make_shared<std::atomic<uint32>>(0)) {}
+
+                boost::asio::io_context context;
+                boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
+                // shared with sockets so that they can release their slot even after the pool is gone
+                std::shared_ptr<std::atomic<uint32>> connections;
+                std::thread thread;
+            };
+
+            explicit AsyncContextPool(size_t shardCount)
+            {
+                if (shardCount == 0)
+                    shardCount = 1;
+
+                for (size_t i = 0; i < shardCount; ++i)
+                    m_shards.emplace_back(std::make_unique<Shard>());
+            }
+
+            ~AsyncContextPool() { Stop(); }
+
+            void Start()
+            {
+                for (auto& shard : m_shards)
+                {
+                    Shard* shardPtr = shard.get();
+                    shard->thread = std::thread([shardPtr]() { shardPtr->context.run(); });
+                }
+            }
+
+            void Stop()
+            {
+                for (auto& shard : m_shards)
+                {
+                    shard->work.reset();
+                    shard->context.stop();
+                }
+
+                for (auto& shard : m_shards)
+                    if (shard->thread.joinable())
+                        shard->thread.join();
+            }
+
+            // shard with the fewest open connections, ties go to the lowest index
+            Shard& GetLeastLoaded()
+            {
+                Shard* result = m_shards[0].get();
+                uint32 lowest = result->connections->load(std::memory_order_relaxed);
+                for (size_t i = 1; i < m_shards.size() && lowest > 0; ++i)
+                {
+                    uint32 load = m_shards[i]->connections->load(std::memory_order_relaxed);
+                    if (load < lowest)
+                    {
+                        lowest = load;
+                        result = m_shards[i].get();
+                    }
+                }
+                return *result;
+            }
+
+            size_t GetShardCount() const { return m_shards.size(); }
+            uint32 GetShardLoad(size_t index) const { return m_shards[index]->connections->load(std::memory_order_relaxed); }
+            boost::asio::io_context& GetContext(size_t index) { return m_shards[index]->context; }
+
+        private:
+            std::vector<std::unique_ptr<Shard>> m_shards;
+    };
+}
+
+#endif
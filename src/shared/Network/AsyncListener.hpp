@@ -23,6 +23,7 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include "AsyncSocket.hpp"
+#include "AsyncContextPool.hpp"
 
 namespace MaNGOS
 {
@@ -31,27 +32,46 @@ namespace MaNGOS
     {
         public:
             // constructor for accepting connection from client
-            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_pool(nullptr), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
             {
                 startAccept();
             }
-            void HandleAccept(std::shared_ptr<SocketType> connection, const boost::system::error_code& err)
+            // constructor for spreading accepted connections over a context pool, acceptor runs on the first shard
+            AsyncListener(AsyncContextPool& pool, std::string const& bindIp, unsigned short port) : m_context(pool.GetContext(0)), m_pool(&pool), m_acceptor(pool.GetContext(0), boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            {
+                startAccept();
+            }
+            void HandleAccept(std::shared_ptr<SocketType> connection, std::shared_ptr<std::atomic<uint32>> load, const boost::system::error_code& err)
             {
                 if (!err)
+                {
+                    if (load)
+                        connection->SetLoadCounter(std::move(load));
                     connection->Start();
+                }
 
                 startAccept();
             }
         private:
             boost::asio::io_context& m_context;
+            AsyncContextPool* m_pool;
             boost::asio::ip::tcp::acceptor m_acceptor;
             void startAccept()
             {
                 // socket
-                std::shared_ptr<SocketType> connection = std::make_shared<SocketType>(m_context);
+                std::shared_ptr<SocketType> connection;
+                std::shared_ptr<std::atomic<uint32>> load;
+                if (m_pool)
+                {
+                    AsyncContextPool::Shard& shard = m_pool->GetLeastLoaded();
+                    connection = std::make_shared<SocketType>(shard.context);
+                    load = shard.connections;
+                }
+                else
+                    connection = std::make_shared<SocketType>(m_context);
 
                 // asynchronous accept operation and wait for a new connection.
-                m_acceptor.async_accept(connection->GetAsioSocket(), boost::bind(&AsyncListener::HandleAccept, this, connection, boost::asio::placeholders::error));
+                m_acceptor.async_accept(connection->GetAsioSocket(), boost::bind(&AsyncListener::HandleAccept, this, connection, load, boost::asio::placeholders::error));
             }
     };
 }
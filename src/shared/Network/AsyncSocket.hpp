@@ -21,6 +21,9 @@
 
 #include "Platform/Define.h"
 #include <boost/asio.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <boost/enable_shared_from_this.hpp>
 #include "boost/lexical_cast.hpp"
 #include "Log/Log.h"
@@ -39,6 +42,9 @@ namespace MaNGOS
             void ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadSkip(size_t skipSize, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // gather write, the memory behind the buffers must stay valid until the callback
+            void Write(std::vector<boost::asio::const_buffer> const& buffers, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            void Post(std::function<void()>&& handler);
 
             bool Start();
             void Close()
@@ -60,6 +66,13 @@ namespace MaNGOS
 
             std::string const& GetRemoteEndpoint() const { return m_remoteEndpoint; }
             std::string const& GetRemoteAddress() const { return m_address; }
+
+            // counts this socket against the load of the context shard it runs on until it is destroyed
+            void SetLoadCounter(std::shared_ptr<std::atomic<uint32>> counter)
+            {
+                m_loadCounter = std::move(counter);
+                ++(*m_loadCounter);
+            }
         private:
             virtual bool ProcessIncomingData() = 0;
             virtual bool OnOpen() = 0;
@@ -71,6 +84,7 @@ namespace MaNGOS
             std::string m_remoteEndpoint;
             boost::asio::ip::address m_remoteAddress;
             uint16 m_remotePort;
+            std::shared_ptr<std::atomic<uint32>> m_loadCounter;
     };
 
     template <typename SocketType>
@@ -83,6 +97,8 @@ namespace MaNGOS
     template <typename SocketType>
     MaNGOS::AsyncSocket<SocketType>::~AsyncSocket()
     {
+        if (m_loadCounter)
+            --(*m_loadCounter);
         m_socket.close();
     }
 
@@ -114,6 +130,18 @@ namespace MaNGOS
         boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
     }
 
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::Write(std::vector<boost::asio::const_buffer> const& buffers, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        boost::asio::async_write(m_socket, buffers, callback);
+    }
+
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::Post(std::function<void()>&& handler)
+    {
+        boost::asio::post(m_socket.get_executor(), std::move(handler));
+    }
+
     template <typename SocketType>
     bool MaNGOS::AsyncSocket<SocketType>::AsyncSocket::Start()
     {